@@ -26,6 +26,7 @@ void setup()
 	//Mode::custom(xres, yres, fixedYDivider = 1) calculates the parameters for our custom resolution.
 	//the y resolution is only scaling integer divisors (yet).
 	//if you don't like to let it scale automatically pass a fixed parameter with a fixed divider.
+	//a fixed x divider (4th parameter) keeps the pixel clock of the original mode and repeats every pixel (interrupt driven modes only).
 	Mode myMode = VGAMode::MODE640x480.custom(80, 60);
 	//print the parameters
 	myMode.print<HardwareSerial>(Serial);
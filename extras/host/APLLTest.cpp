@@ -0,0 +1,62 @@
+/*
+	Author: bitluni 2019
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://youtube.com/bitlunislab
+		https://github.com/bitluni
+		http://bitluni.net
+*/
+
+//checks the APLL solver: the preset table against solve() and the frequencies at the ends of the range
+//build from the repository root and run, it prints the failed checks and exits with their count:
+//  g++ -std=gnu++11 -O2 -Isrc extras/host/APLLTest.cpp -o APLLTest
+
+#include <I2S/APLL.h>
+#include <stdio.h>
+
+static int failures = 0;
+
+static void checkSolve(long frequency, long achieved, const char *what)
+{
+	APLLCoefficients c = APLL::solve(frequency);
+	if (c.achieved == achieved && c.sdm >= 0 && c.sdm <= APLL::sdmMax && c.odir >= 0 && c.odir < 32)
+		return;
+	printf("failed: %s %ld gets %ld (sdm 0x%lx odir %d), expected %ld\n", what, frequency, c.achieved, c.sdm, c.odir, achieved);
+	failures++;
+}
+
+int main()
+{
+	int count;
+	const APLLCoefficients *table = APLL::presets(count);
+	for (int i = 0; i < count; i++)
+	{
+		APLLCoefficients c = APLL::solve(table[i].frequency);
+		if (c.sdm != table[i].sdm || c.odir != table[i].odir || c.achieved != table[i].achieved)
+		{
+			printf("failed: preset %ld differs from solve()\n", table[i].frequency);
+			failures++;
+		}
+		if (APLL::coefficients(table[i].frequency).sdm != table[i].sdm)
+		{
+			printf("failed: preset %ld not taken from the table\n", table[i].frequency);
+			failures++;
+		}
+	}
+	//MODEPAL288Pmin with 16 bit and MODEPALQuarter144P with 8 bit samples, below the VCO minimum
+	checkSolve(4000000, 4000000, "low rate");
+	checkSolve(5000000, 5000000, "low rate");
+	//nothing reaches lower than sdm 0 at the last divider
+	checkSolve(2000000, 2424242, "clamped low rate");
+	//in the VCO range
+	checkSolve(8000000, 8000000, "preset rate");
+	checkSolve(25175000, 25175001, "preset rate");
+	checkSolve(12345678, APLL::solve(12345678, APLL::sdmMin).achieved, "rate in range");
+	//nothing reaches higher than the sdm cap at the first divider
+	checkSolve(200000000, (long)((APLL::outputQ8(APLL::sdmMax, 0) + 128) >> 8), "clamped high rate");
+	printf("%d failed\n", failures);
+	return failures;
+}
@@ -0,0 +1,187 @@
+/*
+	Author: bitluni 2019
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://youtube.com/bitlunislab
+		https://github.com/bitluni
+		http://bitluni.net
+*/
+
+//checks the DMA timelines the engines build their descriptor rings from
+//build from the repository root and run, it prints the failed checks and exits with their count:
+//  g++ -std=gnu++11 -O2 -Isrc extras/host/DMATimelineTest.cpp -o DMATimelineTest
+
+#include <Tools/DMATimeline.h>
+#include <stdio.h>
+
+static int failures = 0;
+
+static void check(bool ok, const char *what, int a = 0, int b = 0)
+{
+	if (ok) return;
+	printf("failed: %s (%d %d)\n", what, a, b);
+	failures++;
+}
+
+enum
+{
+	blank = 0,
+	sync = 1
+};
+
+//vertical blanking of 640x480 (10 front, 2 sync, 33 back) followed by the active lines of two renderer buffers
+static void vga(DMATimeline<8, 2> &t, bool mergeable)
+{
+	t.add(blank, 10, mergeable);
+	t.add(sync, 2, mergeable);
+	t.add(blank, 33, mergeable);
+	t.addData(480);
+	t.addData(480);
+}
+
+static void testLines()
+{
+	static TimelineDescriptor d[2100];
+	DMATimeline<8, 2> t;
+	vga(t, false);
+	check(t.lines() == 45 + 960, "lines", t.lines());
+	check(t.dataLines() == 960, "data lines", t.dataLines());
+	int n = t.compile(2, d, 2100);
+	check(n == 2 * (45 + 960), "two descriptors per line", n);
+	for (int i = 0; i < 90; i++)
+	{
+		check(d[i].segment == TimelineLines && d[i].part == (i & 1) && d[i].line == i / 2, "blanking parts", i, d[i].part);
+		check(d[i].prototype == ((i / 2 >= 10 && i / 2 < 12) ? sync : blank), "blanking prototype", i, d[i].prototype);
+	}
+	check(d[90].segment == TimelineData && d[90].line == 0 && d[90].part == 0 && d[90].prototype == -1, "first data descriptor", d[90].line);
+	check(d[90 + 960].line == 480 && d[90 + 960].part == 0, "second data run continues the active lines", d[90 + 960].line);
+	check(d[n - 1].line == 959 && d[n - 1].part == 1, "last data descriptor", d[n - 1].line, d[n - 1].part);
+	check(t.compile(1) == 45 + 960, "one descriptor per line", t.compile(1));
+}
+
+static void testMerged()
+{
+	static TimelineDescriptor d[2100];
+	DMATimeline<8, 2> t;
+	vga(t, true);
+	int n = t.compile(2, d, 2100);
+	//one descriptor per blanking line, the active lines stay addressable part by part
+	check(n == 45 + 2 * 960, "merged blanking", n);
+	for (int i = 0; i < 45; i++)
+		check(d[i].part == -1 && d[i].line == i, "whole blanking lines", i, d[i].part);
+	check(d[45].segment == TimelineData && d[45].part == 0, "data after the merged blanking", d[45].part);
+	check(t.compile(1) == 45 + 960, "nothing to merge with one descriptor per line", t.compile(1));
+
+	//alike runs are joined, the mergeable flag keeps them apart
+	DMATimeline<2, 2> j;
+	check(j.add(blank, 10, true) && j.add(blank, 5, true) && j.add(sync, 2, true), "alike runs joined");
+	check(!j.add(blank, 1, false), "run limit");
+	check(j.lines() == 17, "lines of joined runs", j.lines());
+	check(!j.add(2, 1, true), "prototype limit");
+	check(j.add(blank, 0, false), "empty runs ignored");
+
+	check(DMATimeline<1>::mergeableLine(4092) && !DMATimeline<1>::mergeableLine(4093) && !DMATimeline<1>::mergeableLine(0), "line fits a descriptor");
+}
+
+enum
+{
+	normal = 0,
+	normalFront = 1,
+	normalBack = 2,
+	equalizing = 3,
+	vSync = 4
+};
+
+//a composite field: 2 normal lines, NF, 5 EQ, 5 SY, 5 EQ, 2 normal lines, 3 active lines
+static void composite(DMATimeline<16, 5> &t, bool mergeable)
+{
+	t.add(normal, 2, mergeable);
+	t.addHalfLines(normalFront, 1);
+	t.addHalfLines(equalizing, 5);
+	t.addHalfLines(vSync, 5);
+	t.addHalfLines(equalizing, 5);
+	t.add(normal, 2, mergeable);
+	t.addData(3);
+}
+
+static void testHalfLines()
+{
+	TimelineDescriptor d[64];
+	DMATimeline<16, 5> t;
+	composite(t, false);
+	check(t.lines() == 2 + 8 + 2 + 3, "lines with half lines", t.lines());
+	int n = t.compile(2, d, 64);
+	check(n == 2 * 15, "a descriptor per half line", n);
+	int expected[16] = {normalFront, equalizing, equalizing, equalizing, equalizing, equalizing, vSync, vSync, vSync, vSync, vSync, equalizing, equalizing, equalizing, equalizing, equalizing};
+	for (int i = 0; i < 16; i++)
+	{
+		TimelineDescriptor &h = d[4 + i];
+		check(h.segment == TimelineHalfLines && h.prototype == expected[i] && h.second == -1, "half line", i, h.prototype);
+		check(h.line == 2 + i / 2 && h.part == (i & 1), "half line position", i, h.line);
+	}
+	check(d[20].segment == TimelineLines && d[20].line == 10 && d[20].part == 0, "lines after the half lines", d[20].line);
+
+	//one descriptor per line pairs the halves
+	n = t.compile(1, d, 64);
+	check(n == 15, "paired half lines", n);
+	for (int i = 0; i < 8; i++)
+	{
+		TimelineDescriptor &h = d[2 + i];
+		check(h.prototype == expected[2 * i] && h.second == expected[2 * i + 1] && h.line == 2 + i && h.part == -1, "pair", i, h.prototype * 10 + h.second);
+	}
+
+	//merged normal lines, the half lines stay one descriptor each
+	DMATimeline<16, 5> m;
+	composite(m, true);
+	check(m.compile(2) == 2 + 16 + 2 + 6, "merged normal lines", m.compile(2));
+
+	//whole lines can not start in the middle of a line, nor can a half line stay unpaired
+	DMATimeline<4, 5> bad;
+	bad.addHalfLines(equalizing, 3);
+	bad.add(normal, 1, false);
+	check(bad.compile(2) == -1 && bad.compile(1) == -1, "line after an odd number of half lines");
+	DMATimeline<4, 5> odd;
+	odd.add(normal, 1, false);
+	odd.addHalfLines(equalizing, 3);
+	check(odd.compile(2) == -1, "unpaired half line at the end");
+	check(odd.compile(3) == -1, "half lines need at most two descriptors per line");
+}
+
+//compiling in chunks gives the same descriptors as compiling the whole timeline
+static void testChunks()
+{
+	static TimelineDescriptor all[2000];
+	TimelineDescriptor chunk[7];
+	DMATimeline<16, 5> t;
+	composite(t, true);
+	composite(t, false);
+	for (int dpl = 1; dpl <= 2; dpl++)
+	{
+		int n = t.compile(dpl, all, 2000);
+		int bad = 0;
+		for (int first = 0; first < n; first += 7)
+		{
+			check(t.compile(dpl, chunk, 7, first) == n, "chunk count", first);
+			for (int i = first; i < n && i < first + 7; i++)
+			{
+				TimelineDescriptor &a = all[i];
+				TimelineDescriptor &c = chunk[i - first];
+				bad += a.segment != c.segment || a.prototype != c.prototype || a.second != c.second || a.line != c.line || a.part != c.part;
+			}
+		}
+		check(bad == 0, "chunks match", dpl, bad);
+	}
+}
+
+int main()
+{
+	testLines();
+	testMerged();
+	testHalfLines();
+	testChunks();
+	printf("%d failed\n", failures);
+	return failures;
+}
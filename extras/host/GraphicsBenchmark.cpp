@@ -0,0 +1,288 @@
+/*
+	Author: bitluni 2019
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://youtube.com/bitlunislab
+		https://github.com/bitluni
+		http://bitluni.net
+*/
+
+//times the drawing primitives of every frame buffer format the engines use, on plain memory
+//build from the repository root:
+//  g++ -std=gnu++11 -O2 -Isrc/Host -Isrc src/Host/*.cpp extras/host/GraphicsBenchmark.cpp -o GraphicsBenchmark
+//usage: GraphicsBenchmark [--json] [--ms milliseconds per measurement]
+//prints one record per format, resolution and primitive: calls, pixels touched, time and pixels per second
+//the pixels of circles and triangles are nominal (outline length, area), the inputs are the same on every run
+//the text buffers count cells instead of pixels
+//GraphicsPAL8Swapped is not measured, it is still written against the old Graphics<Color> and no engine uses it
+
+#include <Arduino.h>
+#include <time.h>
+#include <Graphics/GraphicsR5G5B4A2.h>
+#include <Graphics/GraphicsR5G5B4S2Swapped.h>
+#include <Graphics/GraphicsR2G2B2A2.h>
+#include <Graphics/GraphicsR2G2B2S2Swapped.h>
+#include <Graphics/GraphicsR1G1B1A1.h>
+#include <Graphics/GraphicsR1G1B1X3S2Swapped.h>
+#include <Graphics/GraphicsW1.h>
+#include <Graphics/GraphicsW8.h>
+#include <Graphics/GraphicsTextBuffer.h>
+#include <Graphics/GraphicsAttributeTextBuffer.h>
+#include <Graphics/GraphicsR3G3B2.h>
+#include <Graphics/GraphicsW8RangedSwapped.h>
+#include <Graphics/GraphicsW8RangedSwappedPDM.h>
+#include <Graphics/GraphicsX6S2W8RangedSwapped.h>
+#include <Graphics/GraphicsX8CA8Swapped.h>
+#include <Graphics/GraphicsCA8Swapped.h>
+#include <Graphics/GraphicsM8CA8Swapped.h>
+#include <Graphics/GraphicsR2G2B2A2CA8Swapped.h>
+#include <Graphics/GraphicsW8PDM.h>
+#include <Graphics/BufferLayouts/BLpx2sz8sw3xshx.h>
+#include <Graphics/ColorToBuffer/CTBRangePDM4.h>
+#include <Graphics/BufferLayouts/BLpx4sz8sw3xshx.h>
+#include <Graphics/ColorToBuffer/CTBRangePDM2.h>
+#include <Graphics/Image.h>
+#include <Ressources/Font6x8.h>
+
+//the formats of CompositeGrayPDM4 and CompositeGrayPDM2, they have no class of their own
+class GraphicsW8RangedPDM4 : public GraphicsW8PDM<BLpx2sz8sw3xshx, CTBRangePDM4> {};
+class GraphicsW8RangedPDM2 : public GraphicsW8PDM<BLpx4sz8sw3xshx, CTBRangePDM2> {};
+
+static bool json = false;
+static long long budgetNs = 50000000;
+static bool firstRecord = true;
+
+static long long nanoseconds()
+{
+	timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (long long)t.tv_sec * 1000000000ll + t.tv_nsec;
+}
+
+//same sequence on every run
+static unsigned int seed;
+static int rnd(int range)
+{
+	seed = seed * 1103515245 + 12345;
+	return (int)((seed >> 8) % (unsigned int)range);
+}
+
+static void record(const char *format, int xres, int yres, const char *primitive, long long calls, long long pixels, long long ns)
+{
+	double pixelsPerSecond = ns ? pixels * 1e9 / ns : 0;
+	if (json)
+	{
+		printf("%s\n  {\"format\": \"%s\", \"xres\": %d, \"yres\": %d, \"primitive\": \"%s\", \"calls\": %lld, \"pixels\": %lld, \"ns\": %lld, \"pixelsPerSecond\": %.0f}",
+			firstRecord ? "[" : ",", format, xres, yres, primitive, calls, pixels, ns, pixelsPerSecond);
+	}
+	else
+	{
+		if (firstRecord)
+			printf("format,xres,yres,primitive,calls,pixels,ns,pixelsPerSecond\n");
+		printf("%s,%d,%d,%s,%lld,%lld,%lld,%.0f\n", format, xres, yres, primitive, calls, pixels, ns, pixelsPerSecond);
+	}
+	firstRecord = false;
+}
+
+//calls draw(g) until the time budget is used, draw returns the pixels it touched
+template<class G, class Draw>
+static void measure(G &g, const char *format, const char *primitive, Draw draw)
+{
+	seed = 1;
+	long long calls = 0;
+	long long pixels = 0;
+	long long start = nanoseconds();
+	long long ns = 0;
+	do
+	{
+		//a batch between two clock reads
+		for (int i = 0; i < 64; i++)
+			pixels += draw(g);
+		calls += 64;
+		ns = nanoseconds() - start;
+	} while (ns < budgetNs);
+	record(format, g.xres, g.yres, primitive, calls, pixels, ns);
+}
+
+static uint32_t imageR8G8B8A8Pixels[32 * 32];
+static uint16_t imageR5G5B4A2Pixels[32 * 32];
+static uint8_t imageR2G2B2A2Pixels[32 * 32];
+
+template<class G>
+static void benchmark(const char *format, int xres, int yres)
+{
+	G g;
+	g.setResolution(xres, yres);
+	g.setFont(Font6x8);
+	typename G::Color white = g.RGB(255, 255, 255);
+	typename G::Color gray = g.RGB(128, 128, 128);
+	typename G::Color translucent = g.RGBA(255, 0, 0, 128);
+	Image imageR8G8B8A8(32, 32, imageR8G8B8A8Pixels, Image::R8G8B8A8);
+	Image imageR5G5B4A2(32, 32, imageR5G5B4A2Pixels, Image::R5G5B4A2);
+	Image imageR2G2B2A2(32, 32, imageR2G2B2A2Pixels, Image::R2G2B2A2);
+
+	measure(g, format, "clear", [&](G &g) { g.clear(gray); return (long long)xres * yres; });
+	measure(g, format, "dot", [&](G &g) { g.dot(rnd(xres), rnd(yres), white); return 1ll; });
+	measure(g, format, "dotMix", [&](G &g) { g.dotMix(rnd(xres), rnd(yres), translucent); return 1ll; });
+	measure(g, format, "get", [&](G &g) { return (long long)(g.get(rnd(xres), rnd(yres)) & 1) | 1; });
+	measure(g, format, "xLine", [&](G &g) {
+		int x0 = rnd(xres), x1 = rnd(xres);
+		g.xLine(x0, x1, rnd(yres), white);
+		return (long long)(x0 < x1 ? x1 - x0 : x0 - x1);
+	});
+	measure(g, format, "fillRect", [&](G &g) {
+		int w = 1 + rnd(xres / 4), h = 1 + rnd(yres / 4);
+		g.fillRect(rnd(xres - w), rnd(yres - h), w, h, white);
+		return (long long)w * h;
+	});
+	measure(g, format, "line", [&](G &g) {
+		int x0 = rnd(xres), y0 = rnd(yres), x1 = rnd(xres), y1 = rnd(yres);
+		int dx = x0 < x1 ? x1 - x0 : x0 - x1, dy = y0 < y1 ? y1 - y0 : y0 - y1;
+		g.line(x0, y0, x1, y1, white);
+		return (long long)(dx > dy ? dx : dy) + 1;
+	});
+	measure(g, format, "triangle", [&](G &g) {
+		short v[3][2];
+		for (int i = 0; i < 3; i++)
+		{
+			v[i][0] = rnd(xres);
+			v[i][1] = rnd(yres);
+		}
+		g.triangle(v[0], v[1], v[2], white);
+		long long area = ((long long)(v[1][0] - v[0][0]) * (v[2][1] - v[0][1]) - (long long)(v[2][0] - v[0][0]) * (v[1][1] - v[0][1])) / 2;
+		return area < 0 ? -area : area;
+	});
+	measure(g, format, "circle", [&](G &g) {
+		int r = 1 + rnd(yres / 4);
+		g.circle(rnd(xres), rnd(yres), r, white);
+		return (long long)(2 * 3.14159265 * r);
+	});
+	measure(g, format, "fillCircle", [&](G &g) {
+		int r = 1 + rnd(yres / 4);
+		g.fillCircle(rnd(xres), rnd(yres), r, white);
+		return (long long)(3.14159265 * r * r);
+	});
+	measure(g, format, "drawChar", [&](G &g) {
+		g.drawChar(rnd(xres - 6), rnd(yres - 8), 'A' + rnd(26));
+		return 6ll * 8;
+	});
+	measure(g, format, "print", [&](G &g) {
+		g.setCursor(rnd(xres - 6 * 16), rnd(yres - 8));
+		g.print("benchmark line 1");
+		return 16ll * 6 * 8;
+	});
+	measure(g, format, "imageR8G8B8A8", [&](G &g) {
+		g.imageR8G8B8A8(imageR8G8B8A8, rnd(xres - 32), rnd(yres - 32), 0, 0, 32, 32);
+		return 32ll * 32;
+	});
+	measure(g, format, "imageMixR8G8B8A8", [&](G &g) {
+		g.imageMixR8G8B8A8(imageR8G8B8A8, rnd(xres - 32), rnd(yres - 32), 0, 0, 32, 32);
+		return 32ll * 32;
+	});
+	measure(g, format, "imageR5G5B4A2", [&](G &g) {
+		g.imageR5G5B4A2(imageR5G5B4A2, rnd(xres - 32), rnd(yres - 32), 0, 0, 32, 32);
+		return 32ll * 32;
+	});
+	measure(g, format, "imageR2G2B2A2", [&](G &g) {
+		g.imageR2G2B2A2(imageR2G2B2A2, rnd(xres - 32), rnd(yres - 32), 0, 0, 32, 32);
+		return 32ll * 32;
+	});
+	measure(g, format, "scroll", [&](G &g) { g.scroll(8, gray); return (long long)xres * yres; });
+}
+
+template<class G>
+static void benchmarkResolutions(const char *format)
+{
+	benchmark<G>(format, 320, 240);
+	benchmark<G>(format, 640, 480);
+}
+
+//the text buffers hold one cell per character, only the primitives a terminal uses are measured
+template<class G>
+static void benchmarkText(const char *format, int columns, int rows)
+{
+	G g;
+	g.setResolution(columns, rows);
+	g.setFont(Font6x8);
+
+	measure(g, format, "clear", [&](G &g) { g.clear(); return (long long)columns * rows; });
+	measure(g, format, "dot", [&](G &g) { g.dot(rnd(columns), rnd(rows), 'A'); return 1ll; });
+	measure(g, format, "fillRect", [&](G &g) {
+		int w = 1 + rnd(columns / 4), h = 1 + rnd(rows / 4);
+		g.fillRect(rnd(columns - w), rnd(rows - h), w, h, 'B');
+		return (long long)w * h;
+	});
+	measure(g, format, "drawChar", [&](G &g) {
+		g.drawChar(rnd(columns), rnd(rows), 'A' + rnd(26));
+		return 1ll;
+	});
+	measure(g, format, "print", [&](G &g) {
+		g.setCursor(rnd(columns - 16), rnd(rows));
+		g.print("benchmark line 1");
+		return 16ll;
+	});
+	measure(g, format, "scroll", [&](G &g) { g.scroll(1, g.backColor); return (long long)columns * rows; });
+}
+
+template<class G>
+static void benchmarkTextResolutions(const char *format)
+{
+	//640x480 with the 8x16 and the 9x16 font
+	benchmarkText<G>(format, 80, 30);
+	benchmarkText<G>(format, 71, 30);
+}
+
+int main(int argc, char **argv)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "--json"))
+			json = true;
+		else if (!strcmp(argv[i], "--ms") && i + 1 < argc)
+			budgetNs = atol(argv[++i]) * 1000000ll;
+	}
+	for (int i = 0; i < 32 * 32; i++)
+	{
+		imageR8G8B8A8Pixels[i] = 0x80000000 | (i * 0x010203);
+		imageR5G5B4A2Pixels[i] = (uint16_t)(i * 37);
+		imageR2G2B2A2Pixels[i] = (uint8_t)(i * 7);
+	}
+
+	//VGA14Bit, VGA14BitI
+	benchmarkResolutions<GraphicsR5G5B4S2Swapped>("R5G5B4S2Swapped");
+	benchmarkResolutions<GraphicsR5G5B4A2>("R5G5B4A2");
+	//VGA6Bit, VGA6BitI
+	benchmarkResolutions<GraphicsR2G2B2S2Swapped>("R2G2B2S2Swapped");
+	benchmarkResolutions<GraphicsR2G2B2A2>("R2G2B2A2");
+	//VGA3Bit, VGA3BitI
+	benchmarkResolutions<GraphicsR1G1B1X3S2Swapped>("R1G1B1X3S2Swapped");
+	benchmarkResolutions<GraphicsR1G1B1A1>("R1G1B1A1");
+	//VGA1BitI
+	benchmarkResolutions<GraphicsW1>("W1");
+	//VGA8BitDACI, CompositeGrayDACI, CompositeGrayLadderI
+	benchmarkResolutions<GraphicsW8>("W8");
+	//CompositeColorDACI
+	benchmarkResolutions<GraphicsR3G3B2>("R3G3B2");
+	//VGATextI, CompositeTextDACI
+	benchmarkTextResolutions<GraphicsTextBuffer>("TextBuffer");
+	//VGAAttributeTextI
+	benchmarkTextResolutions<GraphicsAttributeTextBuffer>("AttributeTextBuffer");
+	//composite gray
+	benchmarkResolutions<GraphicsW8RangedSwapped>("W8RangedSwapped");
+	benchmarkResolutions<GraphicsX6S2W8RangedSwapped>("X6S2W8RangedSwapped");
+	benchmarkResolutions<GraphicsW8RangedSwappedPDM>("W8RangedSwappedPDM");
+	benchmarkResolutions<GraphicsW8RangedPDM4>("W8RangedPDM4");
+	benchmarkResolutions<GraphicsW8RangedPDM2>("W8RangedPDM2");
+	//composite color
+	benchmarkResolutions<GraphicsX8CA8Swapped>("X8CA8Swapped");
+	benchmarkResolutions<GraphicsCA8Swapped>("CA8Swapped");
+	benchmarkResolutions<GraphicsM8CA8Swapped>("M8CA8Swapped");
+	benchmarkResolutions<GraphicsR2G2B2A2CA8Swapped>("R2G2B2A2CA8Swapped");
+
+	if (json)
+		printf("\n]\n");
+	return 0;
+}
@@ -0,0 +1,59 @@
+/*
+	Author: bitluni 2019
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://youtube.com/bitlunislab
+		https://github.com/bitluni
+		http://bitluni.net
+*/
+
+//counts the heap of the host tools: malloc, calloc, realloc and free are replaced by counting ones (glibc)
+//include it in a single translation unit, the tools are built from one file each
+#pragma once
+#include <malloc.h>
+
+//bytes allocated on the heap by the whole program, the usable size of every block
+//(the statistics of the heap count cached free chunks as used)
+static long heapBytes = 0;
+
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *__libc_calloc(size_t count, size_t size);
+extern "C" void *__libc_realloc(void *p, size_t size);
+extern "C" void __libc_free(void *p);
+
+extern "C" void *malloc(size_t size)
+{
+	void *p = __libc_malloc(size);
+	if (p)
+		heapBytes += malloc_usable_size(p);
+	return p;
+}
+
+extern "C" void *calloc(size_t count, size_t size)
+{
+	void *p = __libc_calloc(count, size);
+	if (p)
+		heapBytes += malloc_usable_size(p);
+	return p;
+}
+
+extern "C" void *realloc(void *p, size_t size)
+{
+	long old = p ? malloc_usable_size(p) : 0;
+	void *n = __libc_realloc(p, size);
+	if (n)
+		heapBytes += (long)malloc_usable_size(n) - old;
+	else if (!size)
+		heapBytes -= old;
+	return n;
+}
+
+extern "C" void free(void *p)
+{
+	if (p)
+		heapBytes -= malloc_usable_size(p);
+	__libc_free(p);
+}
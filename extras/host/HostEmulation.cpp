@@ -0,0 +1,73 @@
+/*
+	Author: bitluni 2019
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://youtube.com/bitlunislab
+		https://github.com/bitluni
+		http://bitluni.net
+*/
+
+//runs the real engines on a desktop host (Linux) and writes the frames they send as images
+//build from the repository root:
+//  g++ -std=gnu++11 -O2 -Isrc/Host -Isrc src/Host/*.cpp src/I2S/*.cpp src/Tools/*.cpp src/VGA/*.cpp src/Composite/*.cpp extras/host/HostEmulation.cpp -o HostEmulation
+//the I2S devices are emulated (src/I2S/I2S_Host.cpp), time only passes while the program waits (delay, show(true), hostRunFrames)
+
+#include <ESP32Video.h>
+#include <Ressources/Font6x8.h>
+#include <Host/FrameCapture.h>
+
+VGA14BitI vga;
+VGA6Bit vga6;
+CompositeGrayDAC composite;
+
+int main()
+{
+	//interrupt driven mode: the lines are converted in the emulated interrupt
+	vga.init(VGAMode::MODE320x240, VGA14BitI::VGABlackEdition);
+	vga.clear(vga.RGB(0, 0, 80));
+	vga.setFont(Font6x8);
+	vga.setCursor(10, 10);
+	vga.print("hello host");
+	vga.fillRect(50, 50, 100, 60, vga.RGB(255, 0, 0));
+	vga.circle(200, 120, 40, vga.RGB(0, 255, 0));
+
+	FrameCapture capture(vga.mode);
+	capture.attach(vga);
+	capture.capture();
+	vga.hostRunFrames(2);
+	//the bits of red, green and blue in the samples of the 14 bit mode
+	capture.writeVisiblePPM("VGA14BitI.ppm", vga.mode, 0x1f, 0x3e0, 0x3c00);
+	vga.deinit();
+
+	//DMA only mode: the frame buffer is sent as it is
+	vga6.init(VGAMode::MODE320x240, VGA6Bit::VGABlackEdition);
+	vga6.clear(vga6.RGB(0, 0, 255));
+	vga6.fillRect(20, 20, 100, 100, vga6.RGB(255, 255, 0));
+	vga6.show();
+
+	FrameCapture capture6(vga6.mode);
+	capture6.attach(vga6);
+	capture6.capture();
+	vga6.hostRunFrames(2);
+	capture6.writeVisiblePPM("VGA6Bit.ppm", vga6.mode, 0x3, 0xc, 0x30);
+	vga6.deinit();
+
+	//composite: the DAC outputs the upper byte of the samples, the whole frame is written including the syncs
+	composite.init(CompMode::MODEPAL288P);
+	composite.clear(20);
+	composite.fillRect(50, 50, 100, 100, 200);
+	composite.show();
+
+	FrameCapture captureComposite(composite.mode);
+	captureComposite.attach(composite);
+	captureComposite.capture();
+	composite.hostRunFrames(2);
+	captureComposite.writePPM("CompositeGrayDAC.ppm", 0xff00, 0xff00, 0xff00);
+	composite.deinit();
+
+	printf("frames written: %d %d %d\n", capture.complete, capture6.complete, captureComposite.complete);
+	return 0;
+}
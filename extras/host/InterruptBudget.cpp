@@ -0,0 +1,256 @@
+/*
+	Author: bitluni 2019
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://youtube.com/bitlunislab
+		https://github.com/bitluni
+		http://bitluni.net
+*/
+
+//estimates whether the line conversion of the interrupt driven VGA engines keeps up with the beam
+//the real interruptPixelLine functions run on the host, the time they take is scaled to ESP32 cycles
+//build from the repository root (without vectorization, the ESP32 has none either):
+//  g++ -std=gnu++11 -O2 -fno-tree-vectorize -Isrc/Host -Isrc src/Host/*.cpp src/I2S/*.cpp src/Tools/*.cpp src/VGA/*.cpp extras/host/InterruptBudget.cpp -o InterruptBudget
+//usage: InterruptBudget [--csv] [--mhz cpu MHz] [--isr cycles per interrupt] [--batch lines per interrupt]
+//                       [--limit share of the line] [--hdiv samples per pixel] [--factor ESP32 cycles per host cycle]
+//                       [--host-mhz host MHz] [--reference VGA6BitI 320x240 cycles per line]
+//the scale from host to ESP32 is a guess unless --reference is given:
+//build a sketch with I2S_INTERRUPT_STATS, run VGA6BitI in MODE320x240 and pass the average of
+//"Cycles per line min/avg/max" printed by printInterruptStats()
+//a combination is safe when conversion plus the share of the interrupt entry fits in limit * line period,
+//tight when it still fits in the whole line period (no room for anything else) and unsafe beyond
+//"no clock" marks the modes whose sample rate the APLL can not generate (more than 0.5% off)
+
+#include <ESP32Video.h>
+#include <Ressources/Font6x8.h>
+#include <math.h>
+#include <time.h>
+
+static bool csv = false;
+static int cpuMHz = 240;
+static int isrCycles = 250;
+static int batch = 1;
+static double limit = 0.75;
+static int forcedHDiv = 0;
+static double factor = 3;
+static double hostMHz = 0;
+static double reference = 0;
+
+static long long nanoseconds()
+{
+	timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (long long)t.tv_sec * 1000000000ll + t.tv_nsec;
+}
+
+static double readHostMHz()
+{
+	FILE *f = fopen("/proc/cpuinfo", "r");
+	double mhz = 0;
+	if (f)
+	{
+		char line[256];
+		while (fgets(line, sizeof(line), f))
+			if (sscanf(line, "cpu MHz : %lf", &mhz) == 1)
+				break;
+		fclose(f);
+	}
+	return mhz > 0 ? mhz : 3000;
+}
+
+//gives access to the line conversion the interrupt (or the render task) calls
+template<class Engine>
+class Probe : public Engine
+{
+  public:
+	void convert(int y, uint8_t *pixels)
+	{
+		//the pixel line functions expect the same pointer as the interrupt gets
+		this->renderTaskPixelLine(y, pixels, (I2S *)this);
+	}
+};
+
+struct ModeEntry
+{
+	const char *name;
+	const Mode *mode;
+};
+
+static const ModeEntry modes[] = {
+	{"320x240", &VGAMode::MODE320x240},
+	{"320x200", &VGAMode::MODE320x200},
+	{"320x480", &VGAMode::MODE320x480},
+	{"360x200", &VGAMode::MODE360x200},
+	{"360x400", &VGAMode::MODE360x400},
+	{"400x300", &VGAMode::MODE400x300},
+	{"500x480", &VGAMode::MODE500x480},
+	{"640x350", &VGAMode::MODE640x350},
+	{"640x400", &VGAMode::MODE640x400},
+	{"640x480", &VGAMode::MODE640x480},
+	{"720x400", &VGAMode::MODE720x400},
+	{"800x600", &VGAMode::MODE800x600},
+	{"1024x768", &VGAMode::MODE1024x768},
+	{"1280x1024", &VGAMode::MODE1280x1024},
+};
+
+static const int modeCount = sizeof(modes) / sizeof(modes[0]);
+
+static const int sampleRows = 8;
+static const int sampleRepeats = 8;
+
+//host nanoseconds per line: a few rows spread over the frame are converted over and over, the fastest pass counts
+//(they stay in the cache like the rows of one interrupt, anything slower was disturbed by the host,
+//the ESP32 runs the interrupt from IRAM without competition)
+template<class Engine>
+static double measureLine(Probe<Engine> &engine, const Mode &mode)
+{
+	int rows = mode.vRes / mode.vDiv;
+	int sample[sampleRows];
+	for (int i = 0; i < sampleRows; i++)
+		sample[i] = (2 * i + 1) * rows / (2 * sampleRows);
+	//room for 16 bit samples with the widest pixel repetition
+	uint8_t *pixels = (uint8_t *)malloc(mode.hRes * 4 + 16);
+	long long best = 0;
+	long long start = nanoseconds();
+	for (int pass = 0; pass < 200 || nanoseconds() - start < 20000000; pass++)
+	{
+		long long t = nanoseconds();
+		for (int r = 0; r < sampleRepeats; r++)
+			for (int i = 0; i < sampleRows; i++)
+				engine.convert(sample[i], pixels);
+		t = nanoseconds() - t;
+		if (pass == 0 || t < best)
+			best = t;
+	}
+	free(pixels);
+	return (double)best / (sampleRows * sampleRepeats);
+}
+
+template<class Engine>
+static void fill(Probe<Engine> &engine)
+{
+	//some variety so no branch of the converters is skipped
+	unsigned int seed = 1;
+	for (int y = 0; y < engine.yres; y++)
+		for (int x = 0; x < engine.xres; x++)
+		{
+			seed = seed * 1103515245 + 12345;
+			engine.dotFast(x, y, seed >> 16);
+		}
+}
+
+static void header()
+{
+	if (csv)
+		printf("engine,mode,hRes,hDiv,pixelClock,lineNs,budgetCycles,conversionCycles,isrCyclesPerLine,ratio,verdict\n");
+	else
+	{
+		printf("%d MHz, %d ISR cycles per interrupt, %d line(s) per interrupt, limit %.0f%% of the line, %.3f ESP32 cycles per host cycle\n",
+			cpuMHz, isrCycles, batch, limit * 100, factor);
+		printf("%-12s %-10s %5s %4s %9s %8s %8s %8s %6s %7s  %s\n", "engine", "mode", "hRes", "hDiv", "clock", "line ns", "budget", "convert", "isr", "ratio", "verdict");
+	}
+}
+
+//clock is the APLL setup of the engine, the line period follows the pixel clock it really generates
+static void report(const char *engineName, const char *modeName, const Mode &mode, const APLLCoefficients &clock, double hostNs)
+{
+	double pixelClock = clock.frequency ? (double)mode.pixelClock * clock.achieved / clock.frequency : mode.pixelClock;
+	bool reachable = fabs(pixelClock - mode.pixelClock) <= mode.pixelClock * 0.005;
+	double lineNs = 1e9 * mode.pixelsPerLine() / pixelClock;
+	double budget = lineNs * cpuMHz / 1000;
+	double conversion = hostNs * hostMHz / 1000 * factor;
+	double isr = (double)isrCycles / batch;
+	double ratio = (conversion + isr) / budget;
+	const char *verdict = !reachable ? "no clock" : (ratio <= limit ? "safe" : (ratio <= 1 ? "tight" : "unsafe"));
+	if (csv)
+		printf("%s,%s,%d,%d,%.0f,%.1f,%.0f,%.0f,%.0f,%.3f,%s\n", engineName, modeName, mode.hRes, mode.hDiv, pixelClock, lineNs, budget, conversion, isr, ratio, verdict);
+	else
+		printf("%-12s %-10s %5d %4d %9.3f %8.1f %8.0f %8.0f %6.0f %6.1f%%  %s\n", engineName, modeName, mode.hRes, mode.hDiv, pixelClock / 1e6, lineNs, budget, conversion, isr, ratio * 100, verdict);
+}
+
+template<class Engine>
+static double runMode(Probe<Engine> &engine, const Mode &mode, bool first)
+{
+	if (first ? !engine.init(mode, VGAPinConfig::VGABlackEdition) : !engine.reinit(mode))
+		return -1;
+	fill(engine);
+	return measureLine(engine, mode);
+}
+
+template<class Engine>
+static void runEngine(const char *engineName)
+{
+	static Probe<Engine> engine;
+	engine.setFont(Font6x8);
+	for (int i = 0; i < modeCount; i++)
+	{
+		Mode mode = *modes[i].mode;
+		if (forcedHDiv)
+			mode.hDiv = forcedHDiv;
+		double ns = runMode(engine, mode, i == 0);
+		if (ns < 0)
+		{
+			if (!csv)
+				printf("%-12s %-10s init failed\n", engineName, modes[i].name);
+			continue;
+		}
+		report(engineName, modes[i].name, mode, engine.apllClock, ns);
+	}
+	engine.deinit();
+}
+
+int main(int argc, char **argv)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "--csv"))
+			csv = true;
+		else if (i + 1 >= argc)
+			break;
+		else if (!strcmp(argv[i], "--mhz"))
+			cpuMHz = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--isr"))
+			isrCycles = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--batch"))
+		{
+			batch = atoi(argv[++i]);
+			if (batch < 1) batch = 1;
+		}
+		else if (!strcmp(argv[i], "--limit"))
+			limit = atof(argv[++i]);
+		else if (!strcmp(argv[i], "--hdiv"))
+			forcedHDiv = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--factor"))
+			factor = atof(argv[++i]);
+		else if (!strcmp(argv[i], "--host-mhz"))
+			hostMHz = atof(argv[++i]);
+		else if (!strcmp(argv[i], "--reference"))
+			reference = atof(argv[++i]);
+	}
+	Serial.stream = stderr;
+	if (hostMHz <= 0)
+		hostMHz = readHostMHz();
+
+	if (reference > 0)
+	{
+		//scale so the reference combination matches what was measured on the device
+		static Probe<VGA6BitI> calibration;
+		double ns = runMode(calibration, VGAMode::MODE320x240, true);
+		calibration.deinit();
+		if (ns > 0)
+			factor = reference / (ns * hostMHz / 1000);
+	}
+
+	header();
+	runEngine<VGA1BitI>("VGA1BitI");
+	runEngine<VGA3BitI>("VGA3BitI");
+	runEngine<VGA6BitI>("VGA6BitI");
+	runEngine<VGA8BitDACI>("VGA8BitDACI");
+	runEngine<VGA14BitI>("VGA14BitI");
+	runEngine<VGATextI>("VGATextI");
+	runEngine<VGAAttributeTextI>("VGAAttributeTextI");
+	return 0;
+}
@@ -0,0 +1,163 @@
+/*
+	Author: bitluni 2019
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://youtube.com/bitlunislab
+		https://github.com/bitluni
+		http://bitluni.net
+*/
+
+//checks the platform-free parts of the line scheduling of the interrupt driven engines
+//build from the repository root and run, it prints the failed checks and exits with their count:
+//  g++ -std=gnu++11 -O2 -Isrc extras/host/LineSchedulerTest.cpp -o LineSchedulerTest
+
+#include <Tools/LineScheduler.h>
+#include <Tools/LineRequestRing.h>
+#include <stdio.h>
+#include <string.h>
+
+static int failures = 0;
+
+static void check(bool ok, const char *what, int a = 0, int b = 0)
+{
+	if (ok) return;
+	printf("failed: %s (%d %d)\n", what, a, b);
+	failures++;
+}
+
+//sends the frame line by line and runs the scheduler on every lineBatchCount-th line and the last one like the interrupt does
+//skip drops that many interrupts in the middle of the frame, late requests a grow every frame
+//counts how often every line was rendered
+static void runFrames(LineScheduler &s, int frames, int *rendered, int skip = 0, bool late = false)
+{
+	memset(rendered, 0, sizeof(int) * s.totalLines);
+	for (int f = 0; f < frames; f++)
+		for (int line = 0; line < s.totalLines; line++)
+		{
+			if ((line + 1) % s.lineBatchCount && line != s.totalLines - 1)
+				continue;
+			if (skip && line >= s.totalLines / 2 && line < s.totalLines / 2 + skip * s.lineBatchCount)
+				continue;
+			if (late && line == s.lineBatchCount - 1)
+				s.requestGrow();
+			s.schedule(line);
+			for (int i = 0; i < s.pendingLines; i++)
+				rendered[s.line(i)]++;
+			s.finish();
+		}
+}
+
+static void testSteady(int total, int batch, int window)
+{
+	LineScheduler s;
+	s.start(total, batch, window, window);
+	int rendered[1000];
+	runFrames(s, 3, rendered);
+	for (int i = 0; i < total; i++)
+		check(rendered[i] == 3, "every line once per frame", i, rendered[i]);
+	check(s.missedLines == 0, "no missed lines", s.missedLines);
+	check(s.repeatedLines <= 0, "no repeated lines", s.repeatedLines);
+}
+
+static void testSkipped()
+{
+	LineScheduler s;
+	s.start(100, 1, 8, 8);
+	int rendered[100];
+	runFrames(s, 1, rendered, 3);
+	check(s.missedLines == 3, "skipped interrupts counted", s.missedLines);
+	//the lines of the skipped interrupts are caught up, at most the window less the line being sent
+	runFrames(s, 1, rendered, 10);
+	check(s.missedLines == 13, "lost lines counted", s.missedLines);
+	int lost = 0;
+	for (int i = 0; i < 100; i++)
+		lost += rendered[i] == 0;
+	check(lost == 10 - (8 - 1) + 1, "lines beyond the window lost", lost);
+}
+
+static void testRepeats()
+{
+	LineScheduler s;
+	s.start(100, 2, 12, 12);
+	s.schedule(1);
+	s.finish();
+	//a late interrupt has more than two batches to catch up on, the oldest ones repeat
+	s.schedule(9);
+	check(s.pendingLines == 8, "pending lines", s.pendingLines);
+	check(s.repeatedLines == 4, "repeated lines", s.repeatedLines);
+	check(s.repeats(3) && !s.repeats(4), "oldest lines repeat");
+	check(s.line(0) == 14 && s.line(7) == 21, "oldest line first", s.line(0), s.line(7));
+	s.finish();
+	check(s.renderedLine == 21, "rendered line", s.renderedLine);
+}
+
+static void testWrap()
+{
+	LineScheduler s;
+	s.start(10, 1, 4, 4);
+	s.renderedLine = 11 % 10;
+	s.schedule(8);
+	check(s.pendingLines == 1 && s.line(0) == 2, "lines wrap into the next frame", s.pendingLines, s.line(0));
+	s.finish();
+	check(s.renderedLine == 2, "rendered line wraps", s.renderedLine);
+}
+
+static void testGrowAndShrink()
+{
+	LineScheduler s;
+	s.start(100, 1, 4, 6);
+	s.shrinkAfterFrames = 2;
+	int rendered[100];
+	runFrames(s, 4, rendered, 0, true);
+	check(s.renderAheadLines == 6, "window grows up to the line buffers", s.renderAheadLines);
+	check(s.missedLines == 0, "grown lines are not missed", s.missedLines);
+	runFrames(s, 2, rendered);
+	check(s.renderAheadLines == 5, "window shrinks after quiet frames", s.renderAheadLines);
+	runFrames(s, 20, rendered);
+	check(s.renderAheadLines == 4, "window shrinks back to its initial size", s.renderAheadLines);
+	check(s.missedLines == 0, "shrinking loses no line", s.missedLines);
+	//the first lines of the frame were rendered in the previous run as long as the window was larger
+	for (int i = 6; i < 100; i++)
+		check(rendered[i] == 20, "every line once per frame while shrinking", i, rendered[i]);
+}
+
+static void testRing()
+{
+	LineRequestRing<LineRequest, 4> ring;
+	LineRequest r = {0, 0, 0};
+	for (int i = 0; i < 4; i++)
+	{
+		r.line = i;
+		check(ring.push(r), "push until full", i);
+	}
+	check(!ring.push(r), "push when full");
+	check(ring.size() == 4, "size when full", ring.size());
+	for (int i = 0; i < 6; i++)
+	{
+		LineRequest o = {-1, 0, 0};
+		check(ring.pop(o) && o.line == i, "pop in order", i, o.line);
+		r.line = i + 4;
+		check(ring.push(r), "push after pop", i);
+	}
+	check(ring.size() == 4, "size after wrapping", ring.size());
+	ring.clear();
+	LineRequest o;
+	check(!ring.pop(o) && ring.size() == 0, "empty after clear");
+}
+
+int main()
+{
+	testSteady(525, 1, 3);
+	testSteady(525, 2, 4);
+	testSteady(628, 4, 8);
+	testSkipped();
+	testRepeats();
+	testWrap();
+	testGrowAndShrink();
+	testRing();
+	printf("%d failed\n", failures);
+	return failures;
+}
@@ -0,0 +1,85 @@
+/*
+	Author: bitluni 2019
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://youtube.com/bitlunislab
+		https://github.com/bitluni
+		http://bitluni.net
+*/
+
+//switches the real engines between modes on a desktop host (Linux) and checks what stays allocated
+//the heap after deinit must be the same in every cycle, reinit to a smaller mode must not hold the blocks of the larger one
+//build from the repository root and run, it prints the failed checks and exits with their count:
+//  g++ -std=gnu++11 -O2 -Isrc/Host -Isrc src/Host/*.cpp src/I2S/*.cpp src/Tools/*.cpp src/VGA/*.cpp src/Composite/*.cpp extras/host/ReinitLeakTest.cpp -o ReinitLeakTest
+
+#include <ESP32Video.h>
+#include <Ressources/Font6x8.h>
+#include "HeapCount.h"
+
+static int failures = 0;
+
+static void check(bool ok, const char *engine, const char *what, long a = 0, long b = 0)
+{
+	if (ok) return;
+	printf("failed: %s %s (%ld %ld)\n", engine, what, a, b);
+	failures++;
+}
+
+//init with the large mode, reinit to the small one and back, deinit, several times
+template<class Engine, class ModeType, class Init>
+static void testEngine(const char *name, Engine &engine, Init init, const ModeType &large, const ModeType &small)
+{
+	long heap = 0;
+	for (int cycle = 0; cycle < 8; cycle++)
+	{
+		check(init(engine, large), name, "init");
+		engine.hostRunFrames(1);
+		check(engine.reinit(small), name, "reinit");
+		engine.hostRunFrames(1);
+		check(!engine.dmaArena.oversized(), name, "DMA arena kept after reinit", engine.dmaArena.getUsedBytes(), engine.dmaArena.getReservedBytes());
+		check(!engine.frameBufferArena.oversized(), name, "frame arena kept after reinit", engine.frameBufferArena.getUsedBytes(), engine.frameBufferArena.getReservedBytes());
+		check(engine.reinit(large), name, "reinit back");
+		engine.hostRunFrames(1);
+		engine.deinit();
+		check(!engine.dmaArena.getReservedBytes() && !engine.frameBufferArena.getReservedBytes(), name, "arenas after deinit",
+				engine.dmaArena.getReservedBytes(), engine.frameBufferArena.getReservedBytes());
+		//the first cycle may allocate things that are kept for good (the emulated devices)
+		if (cycle == 0)
+			heap = heapBytes;
+		else
+			check(heapBytes == heap, name, "heap after deinit", heapBytes, heap);
+	}
+}
+
+VGA14BitI vga14;
+VGA6Bit vga6;
+VGAAttributeTextI vgaText;
+CompositeGrayDAC grayDAC;
+CompositeGrayDACI grayDACI;
+CompositeColorDACI colorDACI;
+CompositeTextDACI textDACI;
+
+int main()
+{
+	testEngine("VGA14BitI", vga14, [](VGA14BitI &e, const Mode &m) { return e.init(m, VGA14BitI::VGABlackEdition); },
+			VGAMode::MODE640x480, VGAMode::MODE200x150);
+	testEngine("VGA6Bit", vga6, [](VGA6Bit &e, const Mode &m) { return e.init(m, VGA6Bit::VGABlackEdition); },
+			VGAMode::MODE640x480, VGAMode::MODE200x150);
+	vgaText.setFont(Font6x8);
+	testEngine("VGAAttributeTextI", vgaText, [](VGAAttributeTextI &e, const Mode &m) { return e.init(m, VGAAttributeTextI::VGABlackEdition); },
+			VGAMode::MODE640x480, VGAMode::MODE320x240);
+	testEngine("CompositeGrayDAC", grayDAC, [](CompositeGrayDAC &e, const ModeComposite &m) { return e.init(m); },
+			CompMode::MODEPAL576I, CompMode::MODENTSCHalf120P);
+	testEngine("CompositeGrayDACI", grayDACI, [](CompositeGrayDACI &e, const ModeComposite &m) { return e.init(m); },
+			CompMode::MODEPAL576I, CompMode::MODENTSCHalf120P);
+	testEngine("CompositeColorDACI", colorDACI, [](CompositeColorDACI &e, const ModeComposite &m) { return e.init(m); },
+			CompMode::MODEPALColor576I, CompMode::MODENTSCColor120P);
+	textDACI.setFont(Font6x8);
+	testEngine("CompositeTextDACI", textDACI, [](CompositeTextDACI &e, const ModeComposite &m) { return e.init(m); },
+			CompMode::MODEPALColor576I, CompMode::MODENTSCColor120P);
+	printf("%d failed\n", failures);
+	return failures;
+}
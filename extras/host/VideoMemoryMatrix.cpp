@@ -0,0 +1,301 @@
+/*
+	Author: bitluni 2019
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://youtube.com/bitlunislab
+		https://github.com/bitluni
+		http://bitluni.net
+*/
+
+//builds the memory compatibility matrix of the engines: every engine is initialised with every mode on the host
+//(src/I2S/I2S_Host.cpp) and what it really allocated is compared with VideoMemoryPlan of the same engine
+//the sizes are the ones of the ESP32 (12 byte descriptors, 4 byte pointers), the row tables of the host are scaled down
+//build from the repository root:
+//  g++ -std=gnu++11 -O2 -Isrc/Host -Isrc src/Host/*.cpp src/I2S/*.cpp src/Tools/*.cpp src/VGA/*.cpp src/Composite/*.cpp extras/host/VideoMemoryMatrix.cpp -o VideoMemoryMatrix
+//usage: VideoMemoryMatrix [--csv] [--heap bytes free for the engine] [--dma-heap DMA capable bytes] [--tolerance share]
+//fits tells whether the measured memory fits the heap, plan is
+//  match:   the planner is within the tolerance (descriptors and both kinds of memory)
+//  drift:   the profile of the planner does not describe the engine any more
+//  no plan: the planner has no profile for the engine
+//the +regions rows split the screen like a game would (a static status bar above a double-buffered playfield)
+//the engines with an output the host does not emulate (PDM) are not listed
+
+#include <ESP32Video.h>
+#include <Ressources/Font6x8.h>
+#include <Tools/VideoMemoryPlanner.h>
+#include "HeapCount.h"
+
+static bool csv = false;
+static unsigned long heapLimit = 300000;
+static unsigned long dmaHeapLimit = 0;
+static double tolerance = 0.05;
+static int planned = 0;
+static int drifted = 0;
+
+//what an init allocated, in ESP32 bytes
+struct Measured
+{
+	int descriptorCount;
+	unsigned long dmaBytes;
+	unsigned long regularBytes;
+};
+
+template<class Engine>
+static Measured measure(Engine &engine, long heapBefore)
+{
+	Measured m;
+	m.descriptorCount = engine.dmaBufferDescriptorCount;
+	//the descriptors are carved from the DMA arena too
+	m.dmaBytes = engine.dmaArena.getUsedBytes() - (unsigned long)m.descriptorCount * (sizeof(DMABufferDescriptor) - VideoMemoryPlan::descriptorSize);
+	//the rest of the heap is regular memory
+	long regular = heapBytes - heapBefore;
+	regular -= (long)engine.dmaArena.getReservedBytes();
+	regular -= (long)engine.frameBufferArena.getReservedBytes() - (long)engine.frameBufferArena.getUsedBytes();
+	//a row table per frame buffer
+	int tableRows = (engine.yres + Engine::Graphics::static_ypixperunit() - 1) / Engine::Graphics::static_ypixperunit();
+	regular -= (long)engine.frameBufferCount * tableRows * (sizeof(void *) - 4);
+	m.regularBytes = regular > 0 ? regular : 0;
+	return m;
+}
+
+static bool plan(const VideoMemoryProfile *profile, const Mode &mode, int frameBufferCount, const ScreenRegion *regions, int regionCount, VideoMemoryPlan &p)
+{
+	if (!profile)
+		return false;
+	p = VideoMemoryPlan::compute(*profile, mode, frameBufferCount, 0, 1, regions, regionCount);
+	return true;
+}
+
+//the composite engines have no screen regions
+static bool plan(const VideoMemoryProfile *profile, const ModeComposite &mode, int frameBufferCount, const ScreenRegion *regions, int regionCount, VideoMemoryPlan &p)
+{
+	if (!profile)
+		return false;
+	p = VideoMemoryPlan::compute(*profile, mode, frameBufferCount);
+	return true;
+}
+
+//small allocations the planner leaves out (the host I2S) are within the slack
+static const int slackBytes = 256;
+
+static bool near(unsigned long measured, unsigned long planned)
+{
+	double d = (double)measured - (double)planned;
+	d = d < 0 ? -d : d;
+	return d <= slackBytes || d <= tolerance * (double)(measured > planned ? measured : planned);
+}
+
+static void header()
+{
+	if (csv)
+		printf("engine,mode,descriptors,plannedDescriptors,dmaBytes,plannedDmaBytes,regularBytes,plannedRegularBytes,fits,plan\n");
+	else
+	{
+		printf("heap %lu bytes, DMA heap %lu bytes (0: same heap), tolerance %.0f%%\n", heapLimit, dmaHeapLimit, tolerance * 100);
+		printf("%-20s %-22s %13s %17s %17s %9s  %s\n", "engine", "mode", "descriptors", "DMA bytes", "regular bytes", "fits", "plan");
+	}
+}
+
+template<class Engine, class ModeType, class Init>
+static void row(const char *engineName, Engine &engine, Init init, const VideoMemoryProfile *profile, const char *modeName, const ModeType &mode,
+	const ScreenRegion *regions = 0, int regionCount = 0)
+{
+	//the first init of the process allocates what the host keeps for good, only the second one is measured
+	long heapBefore = 0;
+	bool ok = false;
+	for (int pass = 0; pass < 2; pass++)
+	{
+		if (pass)
+			engine.deinit();
+		heapBefore = heapBytes;
+		try
+		{
+			ok = init(engine, mode);
+		}
+		catch (...)
+		{
+			ok = false;
+		}
+		if (!ok)
+			break;
+	}
+	if (!ok || !engine.dmaBufferDescriptors)
+	{
+		engine.deinit();
+		if (csv)
+			printf("%s,%s,,,,,,,init failed,\n", engineName, modeName);
+		else
+			printf("%-20s %-22s init failed\n", engineName, modeName);
+		return;
+	}
+	Measured m = measure(engine, heapBefore);
+	int frameBufferCount = engine.frameBufferCount;
+	engine.deinit();
+
+	VideoMemoryPlan p;
+	bool hasPlan = plan(profile, mode, frameBufferCount, regions, regionCount, p);
+	bool fits = m.dmaBytes + m.regularBytes <= heapLimit && (!dmaHeapLimit || m.dmaBytes <= dmaHeapLimit);
+	const char *verdict = "no plan";
+	if (hasPlan)
+	{
+		planned++;
+		bool match = m.descriptorCount == p.descriptorCount && near(m.dmaBytes, p.dmaBytes()) && near(m.regularBytes, p.regularBytes());
+		if (!match)
+			drifted++;
+		verdict = match ? "match" : "drift";
+	}
+	if (csv)
+	{
+		if (hasPlan)
+			printf("%s,%s,%d,%d,%lu,%lu,%lu,%lu,%s,%s\n", engineName, modeName, m.descriptorCount, p.descriptorCount, m.dmaBytes, p.dmaBytes(), m.regularBytes, p.regularBytes(), fits ? "fits" : "too large", verdict);
+		else
+			printf("%s,%s,%d,,%lu,,%lu,,%s,%s\n", engineName, modeName, m.descriptorCount, m.dmaBytes, m.regularBytes, fits ? "fits" : "too large", verdict);
+	}
+	else
+	{
+		//measured/planned
+		char d[32], dma[32], regular[32];
+		if (hasPlan)
+		{
+			snprintf(d, sizeof(d), "%d/%d", m.descriptorCount, p.descriptorCount);
+			snprintf(dma, sizeof(dma), "%lu/%lu", m.dmaBytes, p.dmaBytes());
+			snprintf(regular, sizeof(regular), "%lu/%lu", m.regularBytes, p.regularBytes());
+		}
+		else
+		{
+			snprintf(d, sizeof(d), "%d", m.descriptorCount);
+			snprintf(dma, sizeof(dma), "%lu", m.dmaBytes);
+			snprintf(regular, sizeof(regular), "%lu", m.regularBytes);
+		}
+		printf("%-20s %-22s %13s %17s %17s %9s  %s\n", engineName, modeName, d, dma, regular, fits ? "fits" : "too large", verdict);
+	}
+}
+
+struct VGAModeEntry
+{
+	const char *name;
+	const Mode *mode;
+};
+
+static const VGAModeEntry vgaModes[] = {
+	{"320x240", &VGAMode::MODE320x240},
+	{"320x200", &VGAMode::MODE320x200},
+	{"360x200", &VGAMode::MODE360x200},
+	{"400x300", &VGAMode::MODE400x300},
+	{"320x480", &VGAMode::MODE320x480},
+	{"640x400", &VGAMode::MODE640x400},
+	{"640x480", &VGAMode::MODE640x480},
+	{"800x600", &VGAMode::MODE800x600},
+	{"1024x768", &VGAMode::MODE1024x768},
+};
+
+struct CompositeModeEntry
+{
+	const char *name;
+	const ModeComposite *mode;
+};
+
+static const CompositeModeEntry compositeModes[] = {
+	{"PAL288P", &CompMode::MODEPAL288P},
+	{"PAL576I", &CompMode::MODEPAL576I},
+	{"PAL576Idiv2", &CompMode::MODEPAL576Idiv2},
+	{"NTSC240P", &CompMode::MODENTSC240P},
+	{"NTSC480I", &CompMode::MODENTSC480I},
+	{"PALColor288P", &CompMode::MODEPALColor288P},
+	{"PALColor576I", &CompMode::MODEPALColor576I},
+	{"NTSCColor240P", &CompMode::MODENTSCColor240P},
+};
+
+template<class Engine>
+static void vgaEngine(const char *engineName, const VideoMemoryProfile *profile)
+{
+	static Engine engine;
+	engine.setFont(Font6x8);
+	for (unsigned int i = 0; i < sizeof(vgaModes) / sizeof(vgaModes[0]); i++)
+		row(engineName, engine, [](Engine &e, const Mode &m) { return e.init(m, VGAPinConfig::VGABlackEdition); }, profile, vgaModes[i].name, *vgaModes[i].mode);
+}
+
+//a static status bar of 48 lines with half the vertical resolution above a double-buffered playfield
+template<class Engine>
+static void vgaRegionEngine(const char *engineName, const VideoMemoryProfile *profile)
+{
+	static Engine engine;
+	engine.setFrameBufferCount(2);
+	engine.addRegion(48, 1, 2);
+	for (unsigned int i = 0; i < sizeof(vgaModes) / sizeof(vgaModes[0]); i++)
+		row(engineName, engine, [](Engine &e, const Mode &m) { return e.init(m, VGAPinConfig::VGABlackEdition); }, profile, vgaModes[i].name, *vgaModes[i].mode,
+			engine.addedRegions, engine.addedRegionCount);
+}
+
+template<class Engine>
+static void compositeEngine(const char *engineName, const VideoMemoryProfile *profile)
+{
+	static Engine engine;
+	engine.setFont(Font6x8);
+	for (unsigned int i = 0; i < sizeof(compositeModes) / sizeof(compositeModes[0]); i++)
+		row(engineName, engine, [](Engine &e, const ModeComposite &m) { return e.init(m, CompositePinConfig::XPlayer); }, profile, compositeModes[i].name, *compositeModes[i].mode);
+}
+
+int main(int argc, char **argv)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "--csv"))
+			csv = true;
+		else if (i + 1 >= argc)
+			break;
+		else if (!strcmp(argv[i], "--heap"))
+			heapLimit = atol(argv[++i]);
+		else if (!strcmp(argv[i], "--dma-heap"))
+			dmaHeapLimit = atol(argv[++i]);
+		else if (!strcmp(argv[i], "--tolerance"))
+			tolerance = atof(argv[++i]);
+	}
+	//the messages of the engines (e.g. the modes they reject) go to stderr
+	Serial.stream = stderr;
+
+	VideoMemoryProfile vga14Bit = VideoMemoryProfile::VGA14Bit();
+	VideoMemoryProfile vga8BitDAC = VideoMemoryProfile::VGA8BitDAC();
+	VideoMemoryProfile vga6Bit = VideoMemoryProfile::VGA6Bit();
+	VideoMemoryProfile vga3Bit = VideoMemoryProfile::VGA3Bit();
+	VideoMemoryProfile vga14BitI = VideoMemoryProfile::VGA14BitI();
+	VideoMemoryProfile vga8BitDACI = VideoMemoryProfile::VGA8BitDACI();
+	VideoMemoryProfile vga6BitI = VideoMemoryProfile::VGA6BitI();
+	VideoMemoryProfile vga3BitI = VideoMemoryProfile::VGA3BitI();
+	VideoMemoryProfile vga1BitI = VideoMemoryProfile::VGA1BitI();
+	VideoMemoryProfile vgaTextI = VideoMemoryProfile::VGATextI(Font6x8);
+	VideoMemoryProfile vgaAttributeTextI = VideoMemoryProfile::VGAAttributeTextI(Font6x8);
+	VideoMemoryProfile compositeGrayDAC = VideoMemoryProfile::CompositeGrayDAC();
+	VideoMemoryProfile compositeGrayDACI = VideoMemoryProfile::CompositeGrayDACI();
+	VideoMemoryProfile compositeGrayLadder = VideoMemoryProfile::CompositeGrayLadder();
+	VideoMemoryProfile compositeGrayLadderI = VideoMemoryProfile::CompositeGrayLadderI();
+	VideoMemoryProfile compositeColorDACI = VideoMemoryProfile::CompositeColorDACI();
+	VideoMemoryProfile compositeTextDACI = VideoMemoryProfile::CompositeTextDACI(Font6x8);
+
+	header();
+	vgaEngine<VGA14Bit>("VGA14Bit", &vga14Bit);
+	vgaEngine<VGA8BitDAC>("VGA8BitDAC", &vga8BitDAC);
+	vgaEngine<VGA6Bit>("VGA6Bit", &vga6Bit);
+	vgaEngine<VGA3Bit>("VGA3Bit", &vga3Bit);
+	vgaEngine<VGA14BitI>("VGA14BitI", &vga14BitI);
+	vgaEngine<VGA8BitDACI>("VGA8BitDACI", &vga8BitDACI);
+	vgaEngine<VGA6BitI>("VGA6BitI", &vga6BitI);
+	vgaEngine<VGA3BitI>("VGA3BitI", &vga3BitI);
+	vgaEngine<VGA1BitI>("VGA1BitI", &vga1BitI);
+	vgaEngine<VGATextI>("VGATextI", &vgaTextI);
+	vgaEngine<VGAAttributeTextI>("VGAAttributeTextI", &vgaAttributeTextI);
+	vgaRegionEngine<VGA6Bit>("VGA6Bit+regions", &vga6Bit);
+	vgaRegionEngine<VGA6BitI>("VGA6BitI+regions", &vga6BitI);
+	compositeEngine<CompositeGrayDAC>("CompositeGrayDAC", &compositeGrayDAC);
+	compositeEngine<CompositeGrayDACI>("CompositeGrayDACI", &compositeGrayDACI);
+	compositeEngine<CompositeGrayLadder>("CompositeGrayLadder", &compositeGrayLadder);
+	compositeEngine<CompositeGrayLadderI>("CompositeGrayLadderI", &compositeGrayLadderI);
+	compositeEngine<CompositeColorDACI>("CompositeColorDACI", &compositeColorDACI);
+	compositeEngine<CompositeTextDACI>("CompositeTextDACI", &compositeTextDACI);
+	if (!csv)
+		printf("%d of %d planned combinations drift\n", drifted, planned);
+	return 0;
+}
@@ -119,6 +119,15 @@ const ModeComposite CompMode::MODEPAL576Idiv3(12, 38, 62, 400,  1,  5, 5, 5,  15
 //312.5 lines/field, 20 ms/field, 50 Hz vSync
 
 
+const ModeComposite CompMode::MODEPAL576Idiv2(12, 38, 62, 400,  1,  5, 5, 5,  15, 288, 1, 0, 2, 1, 2, 8000000);
+//625 line / 25 frame
+//288 rows shown in both fields (field-doubled)
+
+//125 ns/pix
+//512 pix/line, 64 us/line, 15.625 kHz hSync, 4.75 us hSync
+//312.5 lines/field, 20 ms/field, 50 Hz vSync
+
+
 
 //==========
 //NTSC MODES
@@ -180,6 +189,8 @@ const ModeComposite CompMode::MODENTSC480Imax(20, 64, 76, 688,  1,  6, 6, 6,  12
 //===========
 const ModeComposite CompMode::MODEPALColor288P(18, 56, 94, 600,  1+78,  6, 5, 5,  15+10, 288-88, 0, 0, 0, 0, 1, 11989505,10,25,4433619,true);
 const ModeComposite CompMode::MODEPALColor288Pmid(14, 34, 40, 376,  1,  6, 5, 5,  15, 288, 0, 0, 0, 0, 1, 7243659,6,20,4433619,true);
+const ModeComposite CompMode::MODEPALColor576I(14, 34, 40, 376,  1,  5, 5, 5,  15, 288, 1, 0, 2, 1, 1, 7243659,6,20,4433619,true);
+const ModeComposite CompMode::MODEPALColor576Idiv2(14, 34, 40, 376,  1,  5, 5, 5,  15, 288, 1, 0, 2, 1, 2, 7243659,6,20,4433619,true);
 const ModeComposite CompMode::MODENTSCColor240P(24, 56, 72, 648,  1+36,  6, 6, 6,  12+4, 240-40, 0, 0, 0, 0, 1, 12560000,13,32,3579545,false);
 const ModeComposite CompMode::MODENTSCColor120P(24, 56, 72, 648,  1,  6, 6, 6,  12, 240, 0, 0, 0, 0, 2, 12560000,13,32,3579545,false);
 
@@ -25,8 +25,11 @@ class CompMode
 	static const ModeComposite MODEPAL576Imax; // OOM in DAC, in Ladder, in 8266
 	static const ModeComposite MODEPAL576Imin; // does not work in ladder, OOM in CompositeGrayPDM8-8266, CompositeGrayPDM4-8266 (unusable stripes), insufficient sync in CompositeGrayPDM2-8266
 	static const ModeComposite MODEPAL576Idiv3; // OOM in CompositeGrayPDM8/4-8266
+	static const ModeComposite MODEPAL576Idiv2; // field-doubled 576I, 288 rows
 	static const ModeComposite MODEPALColor288P; // OOM in CompositeGrayPDM8/4-8266
 	static const ModeComposite MODEPALColor288Pmid; // OOM in CompositeGrayPDM8/4-8266
+	static const ModeComposite MODEPALColor576I; // only for CompositeColorDACI (1 byte per pixel)
+	static const ModeComposite MODEPALColor576Idiv2; // field-doubled, 288 rows
 
 	static const ModeComposite MODENTSC240P; // OOM in CompositeGrayPDM8/4-8266, incorrect sync in CompositeGrayPDM2-8266
 	static const ModeComposite MODENTSCHalf120P; // incorrect sync in CompositeGrayPDM?-8266
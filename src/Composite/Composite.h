@@ -12,6 +12,7 @@
 #pragma once
 
 #include "../I2S/I2S.h"
+#include "../Tools/FrameSync.h"
 #include "ModeComposite.h"
 #include "PinConfigComposite.h"
 
@@ -25,6 +26,10 @@ class Composite : public I2S, public CompMode, public CompositePinConfig
 		: I2S(i2sIndex)
 	{
 		dmaBufferDescriptors = 0;
+#ifndef ESP8266
+		//engines rendering lines in the interrupt replace it
+		interruptStaticChild = &Composite::frameInterrupt;
+#endif
 	}
 
 	virtual bool init(const ModeComposite &mode, const int *pinMap, const int bitCount)
@@ -38,6 +43,7 @@ class Composite : public I2S, public CompMode, public CompositePinConfig
 		propagateResolution(xres, yres);
 		totalLines = mode.linesPerField();
 		allocateLineBuffers();
+		markFrameInterrupt();
 		currentLine = 0;
 		vSyncPassed = false;
 		initParallelOutputMode(pinMap, mode.pixelClock, bitCount);
@@ -49,6 +55,13 @@ class Composite : public I2S, public CompMode, public CompositePinConfig
 
 	ModeComposite mode;
 
+	//frames signalled by the interrupt since init
+	unsigned long frameCount() const { return frameSync.frameCount(); }
+	//blocks until the next frame starts, letting other tasks (or the idle task) use the cpu
+	bool waitForVSync(unsigned long timeoutMs = 0xffffffff) { return frameSync.waitForVSync(timeoutMs); }
+	//called from the interrupt once per frame (keep it short and in IRAM)
+	void setVBlankCallback(void (*callback)(unsigned long frame, void *arg), void *arg = 0) { frameSync.setVBlankCallback(callback, arg); }
+
 	virtual int bytesPerSample() const = 0;
 
   protected:	
@@ -56,10 +69,44 @@ class Composite : public I2S, public CompMode, public CompositePinConfig
 	int currentLine;
 	int totalLines;	
 	volatile bool vSyncPassed;
+	FrameSync frameSync;
 	int syncLevel;
 	int blankLevel;
 	int burstAmp;
 
+#ifndef ESP8266
+	//the DMA-only engines still take one interrupt per frame to signal it
+	//(not on ESP8266, FrameSync is ESP32 only and the SLC interrupt stays off there)
+	bool useInterrupt()
+	{
+		return true;
+	}
+
+	static void IRAM_ATTR frameInterrupt(void *arg)
+	{
+		Composite * staticthis = (Composite *)arg;
+		staticthis->vSyncPassed = true;
+		FrameSync::signalFromISR(&staticthis->frameSync, staticthis->totalLines - 1);
+	}
+#endif
+
+	//the interrupt only signals the frame (DMA-only engines)
+	bool frameInterruptOnly() const
+	{
+#ifndef ESP8266
+		return interruptStaticChild == &Composite::frameInterrupt;
+#else
+		return false;
+#endif
+	}
+
+	//only the last descriptor of the frame ring raises the frame interrupt
+	void markFrameInterrupt()
+	{
+		for (int i = 0; i < dmaBufferDescriptorCount; i++)
+			dmaBufferDescriptors[i].setEOF(i == dmaBufferDescriptorCount - 1);
+	}
+
 
 	// simple ringbuffer of blocks of size bytes each
 	void allocateLineBuffers(const int lines)
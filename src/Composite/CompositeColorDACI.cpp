@@ -0,0 +1,43 @@
+/*
+	Author: Martin-Laclaustra 2021
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://github.com/bitluni
+*/
+
+/*
+	CONNECTION
+	
+	A) voltageDivider = false; B) voltageDivider = true
+	
+	ESP32        TV           ESP32                       TV     
+	-----+                     -----+    ____ 100 ohm
+	    G|-                        G|---|____|+          
+	pin25|--------- Comp       pin25|---|____|+--------- Comp    
+	pin26|-                    pin26|-        220 ohm
+	     |                          |
+	     |                          |
+	-----+                     -----+
+	
+	Connect pin 25 or 26
+*/
+
+#include <Composite/CompositeColorDACI.h>
+
+void IRAM_ATTR CompositeColorDACI::interruptPixelLine(int y, uint32_t *pixels, void *arg, int parity)
+{
+	CompositeColorDACI * staticthis = (CompositeColorDACI *)arg;
+	const uint8_t *indices = staticthis->frontBuffer[y];
+	const uint8_t *steps = staticthis->columnPhaseStep;
+	const uint8_t *levels = &staticthis->paletteLUT[parity * 256 * phaseSteps];
+	for (int i = 0; i < staticthis->mode.hRes / 2; i++)
+	{
+		//two samples per write, the level goes to the MSByte of each
+		pixels[i] = 
+			(levels[(indices[i * 2 + 1] << phaseStepBits) + steps[i * 2 + 1]] << 8)
+			| (levels[(indices[i * 2] << phaseStepBits) + steps[i * 2]] << 24);
+	}
+}
@@ -0,0 +1,120 @@
+/*
+	Author: Martin-Laclaustra 2021
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://github.com/bitluni
+*/
+
+/*
+	CONNECTION
+	
+	A) voltageDivider = false; B) voltageDivider = true
+	
+	ESP32        TV           ESP32                       TV     
+	-----+                     -----+    ____ 100 ohm
+	    G|-                        G|---|____|+          
+	pin25|--------- Comp       pin25|---|____|+--------- Comp    
+	pin26|-                    pin26|-        220 ohm
+	     |                          |
+	     |                          |
+	-----+                     -----+
+	
+	Connect pin 25 or 26
+*/
+#pragma once
+#include "CompositeModulatedDACI.h"
+#include "../Graphics/GraphicsR3G3B2.h"
+
+
+//color from an 8 bit palette index frame buffer, modulated line by line in the interrupt
+//every palette entry has the output level precalculated for each of phaseSteps subcarrier phases
+//(and for both line parities in PAL), so the buffer takes 1 byte per pixel instead of 2 per sample
+//the palette can be changed at any time, the next lines sent use the new colors
+class CompositeColorDACI : public CompositeModulatedDACI<GraphicsR3G3B2> // GraphicsR3G3B2 (=) Graphics<ColorR3G3B2, BLpx1sz8sw0sh0, CTBIdentity>
+{
+  public:
+	CompositeColorDACI()
+	{
+		//default palette: the index is the R3G3B2 color
+		for (int i = 0; i < 256; i++)
+			palette[i] = ColorR8G8B8A8::static_RGBA(R(i), G(i), B(i));
+		modulatedPixelLine = &CompositeColorDACI::interruptPixelLine;
+	}
+
+	~CompositeColorDACI()
+	{
+		deinit();
+	}
+
+	bool initenginePreparation(const ModeComposite &mode, const int *pinMap, const int bitCount, const int clockPin = -1, int descriptorsPerLine = 2)
+	override
+	{
+		if (mode.colorClock == 0)
+		{
+			ERROR("CompositeColorDACI needs a color mode");
+			return false;
+		}
+		return CompositeModulatedDACI<GraphicsR3G3B2>::initenginePreparation(mode, pinMap, bitCount, clockPin, descriptorsPerLine);
+	}
+
+	//changes the color the index is displayed with
+	//to change the palette without tearing call waitForVSync first
+	void setPaletteColor(int index, int r, int g, int b)
+	{
+		index &= 0xff;
+		palette[index] = ColorR8G8B8A8::static_RGBA(r, g, b);
+		if (paletteLUT)
+			modulatePaletteColor(index);
+	}
+
+	uint32_t getPaletteColor(int index) const
+	{
+		return palette[index & 0xff];
+	}
+
+	void releaseFrameMemory(bool keepMemory)
+	override
+	{
+		CompositeModulatedDACI<GraphicsR3G3B2>::releaseFrameMemory(keepMemory);
+		if (keepMemory)
+			return;
+		free(paletteLUT);
+		paletteLUT = 0;
+	}
+
+  protected:
+	uint32_t palette[256];
+	uint8_t *paletteLUT = 0; // [line parity][palette index][phase step], lineParities entries
+
+	//the output levels of all the palette
+	bool modulateLevels()
+	override
+	{
+		//one line parity in NTSC, two in PAL
+		paletteLUT = (uint8_t *)realloc(paletteLUT, lineParities * 256 * phaseSteps);
+		if (!paletteLUT)
+		{
+			ERROR("Not enough memory for the color modulation tables");
+			return false;
+		}
+		for (int i = 0; i < 256; i++)
+			modulatePaletteColor(i);
+		return true;
+	}
+
+	void modulatePaletteColor(int index)
+	{
+		const CTBCompositeCache::Chroma &c = modulator.chroma(palette[index] & 0x00ffffff);
+		for (int parity = 0; parity < lineParities; parity++)
+		{
+			uint8_t *levels = &paletteLUT[(parity * 256 + index) * phaseSteps];
+			for (int step = 0; step < phaseSteps; step++)
+				levels[step] = modulator.signal(c, step << (8 - phaseStepBits), parity);
+		}
+	}
+
+	static void interruptPixelLine(int y, uint32_t *pixels, void *arg, int parity);
+};
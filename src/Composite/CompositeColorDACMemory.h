@@ -110,6 +110,7 @@ class CompositeColorDACMemory : public Composite, public GraphicsM8CA8Swapped
 		propagateResolution(xres, yres);
 		totalLines = mode.linesPerFrame;
 		allocateLineBuffers();
+		markFrameInterrupt();
 		currentLine = 0;
 		vSyncPassed = false;
 		initParallelOutputMode(pinMap, mode.pixelClock, bitCount, clockPin);
@@ -317,9 +318,12 @@ class CompositeColorDACMemory : public Composite, public GraphicsM8CA8Swapped
 		}
 		for (int i = 0; i < mode.vActive; i++)
 		{
-			dmaBufferDescriptors[d].setBuffer(vBlankLineBuffer[(d/2)&1], bytesHSync);
+			//the fields take alternate rows of the same buffer (both the same row if vDiv is even)
+			//the burst has to match the V phase the row was drawn with
+			int row = (i*(mode.interlaced?2:1)) / mode.vDiv;
+			dmaBufferDescriptors[d].setBuffer(vBlankLineBuffer[lineParity(row, mode.vDiv, mode.interlaced) ^ 1], bytesHSync);
 			d++;
-			dmaBufferDescriptors[d++].setBuffer(frameBuffer[(i*(mode.interlaced?2:1) - (mode.interlaced?1:0)) / mode.vDiv], mode.hRes * bytesPerSample());
+			dmaBufferDescriptors[d++].setBuffer(frameBuffer[row], mode.hRes * bytesPerSample());
 		}
 		for (int i = 0; i < mode.vFront; i++)
 		{
@@ -380,9 +384,10 @@ class CompositeColorDACMemory : public Composite, public GraphicsM8CA8Swapped
 		}
 		for (int i = 0; i < mode.vActive; i++)
 		{
-			dmaBufferDescriptors[d].setBuffer(vBlankLineBuffer[(d/2)&1], bytesHSync);
+			int row = (i*2 + 1) / mode.vDiv;
+			dmaBufferDescriptors[d].setBuffer(vBlankLineBuffer[lineParity(row, mode.vDiv, mode.interlaced) ^ 1], bytesHSync);
 			d++;
-			dmaBufferDescriptors[d++].setBuffer(frameBuffer[(i*2) / mode.vDiv], mode.hRes * bytesPerSample());
+			dmaBufferDescriptors[d++].setBuffer(frameBuffer[row], mode.hRes * bytesPerSample());
 		}
 		for (int i = 0; i < mode.vFront; i++)
 		{
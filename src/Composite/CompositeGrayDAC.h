@@ -94,6 +94,7 @@ class CompositeGrayDAC : public CompositeI2SEngine<BLpx1sz16sw1sh8>, public Grap
 
 	bool initoverlappingbuffers(const ModeComposite &mode, const int *pinMap, const int bitCount, const int clockPin = -1)
 	{
+		saveInitPins(pinMap, bitCount, clockPin);
 		//values must be shifted to the MSByte to be output
 		//which is equivalent to multiplying by 256
 		//instead of shifting, do not divide here:
@@ -110,6 +111,19 @@ class CompositeGrayDAC : public CompositeI2SEngine<BLpx1sz16sw1sh8>, public Grap
 
 	//THE REST OF THE FILE IS SHARED CODE BETWEEN ...
 
+	bool initWithSavedPins(const ModeComposite &mode)
+	override
+	{
+		return initoverlappingbuffers(mode, initPinMap, initBitCount, initClockPin);
+	}
+
+	void releaseFrameMemory(bool keepMemory)
+	override
+	{
+		releaseFrameBuffers(keepMemory);
+		currentBufferToAssign = 0;
+	}
+
 	virtual void propagateResolution(const int xres, const int yres)
 	{
 		setResolution(xres, yres);
@@ -119,7 +133,7 @@ class CompositeGrayDAC : public CompositeI2SEngine<BLpx1sz16sw1sh8>, public Grap
 
 	virtual BufferGraphicsUnit **allocateFrameBuffer()
 	{
-		void **arr = (void **)malloc(yres * sizeof(void *));
+		void **arr = (void **)frameBufferArena.allocate(yres * sizeof(void *), false);
 		if(!arr)
 			ERROR("Not enough memory");
 		for (int y = 0; y < yres; y++)
@@ -99,6 +99,7 @@ class CompositeGrayDACI : public CompositeI2SEngine<BLpx1sz16sw1sh8>, public Gra
 
 	bool initdynamicwritetorenderbuffer(const ModeComposite &mode, const int *pinMap, const int bitCount, const int clockPin = -1)
 	{
+		saveInitPins(pinMap, bitCount, clockPin);
 		//values must be shifted to the MSByte to be output
 		//which is equivalent to multiplying by 256
 		//instead of shifting, do not divide here:
@@ -108,13 +109,32 @@ class CompositeGrayDACI : public CompositeI2SEngine<BLpx1sz16sw1sh8>, public Gra
 		baseBufferValue = colorMinValue;
 		syncBufferValue = syncLevel;
 
-		lineBufferCount = 3;
+		//keep a full batch of slack ahead of the beam when several lines are rendered per interrupt
+		lineBufferCount = (2 * lineBatchCount > 3) ? 2 * lineBatchCount : 3;
 		rendererBufferCount = 1;
 		return initengine(mode, pinMap, bitCount, clockPin, 1); // 1 buffer per line
 	}
 
 	//THE REST OF THE FILE IS SHARED CODE BETWEEN ...
 
+	bool initWithSavedPins(const ModeComposite &mode)
+	override
+	{
+		return initdynamicwritetorenderbuffer(mode, initPinMap, initBitCount, initClockPin);
+	}
+
+	void releaseFrameMemory(bool keepMemory)
+	override
+	{
+		releaseFrameBuffers(keepMemory);
+	}
+
+	bool frameMemoryOversized()
+	override
+	{
+		return frameBufferArena.oversized();
+	}
+
 	virtual void propagateResolution(const int xres, const int yres)
 	{
 		setResolution(xres, yres);
@@ -125,11 +145,7 @@ class CompositeGrayDACI : public CompositeI2SEngine<BLpx1sz16sw1sh8>, public Gra
 		if (!frameBufferCount)
 			return;
 		if (vSync)
-		{
-			vSyncPassed = false;
-			while (!vSyncPassed)
-				delay(0);
-		}
+			waitForVSync();
 		Graphics::show(vSync);
 	}
 
@@ -141,5 +157,5 @@ class CompositeGrayDACI : public CompositeI2SEngine<BLpx1sz16sw1sh8>, public Gra
 
 	static void interrupt(void *arg);
 
-	static void interruptPixelLine(int y, uint8_t *pixels, void *arg);
+	static void interruptPixelLine(int y, uint8_t *lineBuffer, void *arg, int renderLine);
 };
@@ -87,6 +87,7 @@ class CompositeGrayLadderI : public CompositeI2SEngine<BLpx1sz8sw2sh0>, public G
 
 	bool initdynamicwritetorenderbuffer(const ModeComposite &mode, const int *pinMap, const int bitCount, const int clockPin = -1)
 	{
+		saveInitPins(pinMap, bitCount, clockPin);
 		//values must be divided to fit 8bits
 		//instead of using a float, bitshift 8 bits to the right later:
 		//colorDepthConversionFactor = (colorMaxValue - colorMinValue + 1)/256;
@@ -95,13 +96,32 @@ class CompositeGrayLadderI : public CompositeI2SEngine<BLpx1sz8sw2sh0>, public G
 		baseBufferValue = colorMinValue;
 		syncBufferValue = syncLevel;
 
-		lineBufferCount = 3;
+		//keep a full batch of slack ahead of the beam when several lines are rendered per interrupt
+		lineBufferCount = (2 * lineBatchCount > 3) ? 2 * lineBatchCount : 3;
 		rendererBufferCount = 1;
 		return initengine(mode, pinMap, bitCount, clockPin, 1); // 1 buffer per line
 	}
 
 	//THE REST OF THE FILE IS SHARED CODE BETWEEN ...
 
+	bool initWithSavedPins(const ModeComposite &mode)
+	override
+	{
+		return initdynamicwritetorenderbuffer(mode, initPinMap, initBitCount, initClockPin);
+	}
+
+	void releaseFrameMemory(bool keepMemory)
+	override
+	{
+		releaseFrameBuffers(keepMemory);
+	}
+
+	bool frameMemoryOversized()
+	override
+	{
+		return frameBufferArena.oversized();
+	}
+
 	virtual void propagateResolution(const int xres, const int yres)
 	{
 		setResolution(xres, yres);
@@ -112,11 +132,7 @@ class CompositeGrayLadderI : public CompositeI2SEngine<BLpx1sz8sw2sh0>, public G
 		if (!frameBufferCount)
 			return;
 		if (vSync)
-		{
-			vSyncPassed = false;
-			while (!vSyncPassed)
-				delay(0);
-		}
+			waitForVSync();
 		Graphics::show(vSync);
 	}
 
@@ -128,5 +144,5 @@ class CompositeGrayLadderI : public CompositeI2SEngine<BLpx1sz8sw2sh0>, public G
 
 	static void interrupt(void *arg);
 
-	static void interruptPixelLine(int y, uint8_t *pixels, void *arg);
+	static void interruptPixelLine(int y, uint8_t *lineBuffer, void *arg, int renderLine);
 };
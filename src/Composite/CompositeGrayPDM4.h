@@ -26,11 +26,11 @@
 */
 #pragma once
 #include "CompositeI2SEngine.h"
-#include "../Graphics/Graphics.h"
+#include "../Graphics/GraphicsW8PDM.h"
 #include "../Graphics/BufferLayouts/BLpx2sz8sw3xshx.h"
 #include "../Graphics/ColorToBuffer/CTBRangePDM4.h"
 
-class CompositeGrayPDM4 : public CompositeI2SEngine<BLpx2sz8sw3xshx>, public Graphics<ColorW8, BLpx2sz8sw3xshx, CTBRangePDM4>
+class CompositeGrayPDM4 : public CompositeI2SEngine<BLpx2sz8sw3xshx>, public GraphicsW8PDM<BLpx2sz8sw3xshx, CTBRangePDM4> // (=) Graphics<ColorW8, BLpx2sz8sw3xshx, CTBRangePDM4>
 {
   public:
 	CompositeGrayPDM4() //8 bit based modes only work with I2S1
@@ -123,6 +123,7 @@ class CompositeGrayPDM4 : public CompositeI2SEngine<BLpx2sz8sw3xshx>, public Gra
 
 	bool initoverlappingbuffers(const ModeComposite &mode, const int *pinMap, const int bitCount, const int clockPin = -1)
 	{
+		saveInitPins(pinMap, bitCount, clockPin);
 		//values must be divided to fit 8bits
 		//instead of using a float, bitshift 8 bits to the right later:
 		//colorDepthConversionFactor = (colorMaxValue - colorMinValue + 1)/256;
@@ -141,6 +142,19 @@ class CompositeGrayPDM4 : public CompositeI2SEngine<BLpx2sz8sw3xshx>, public Gra
 
 	//THE REST OF THE FILE IS SHARED CODE BETWEEN ...
 
+	bool initWithSavedPins(const ModeComposite &mode)
+	override
+	{
+		return initoverlappingbuffers(mode, initPinMap, initBitCount, initClockPin);
+	}
+
+	void releaseFrameMemory(bool keepMemory)
+	override
+	{
+		releaseFrameBuffers(keepMemory);
+		currentBufferToAssign = 0;
+	}
+
 	virtual void propagateResolution(const int xres, const int yres)
 	{
 		setResolution(xres, yres);
@@ -150,7 +164,7 @@ class CompositeGrayPDM4 : public CompositeI2SEngine<BLpx2sz8sw3xshx>, public Gra
 
 	virtual BufferGraphicsUnit **allocateFrameBuffer()
 	{
-		void **arr = (void **)malloc(yres * sizeof(void *));
+		void **arr = (void **)frameBufferArena.allocate(yres * sizeof(void *), false);
 		if(!arr)
 			ERROR("Not enough memory");
 		for (int y = 0; y < yres; y++)
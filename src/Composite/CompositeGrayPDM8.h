@@ -102,6 +102,7 @@ class CompositeGrayPDM8 : public CompositeI2SEngine<BLpx1sz8sw3sh0>, public Grap
 
 	bool initoverlappingbuffers(const ModeComposite &mode, const int *pinMap, const int bitCount, const int clockPin = -1)
 	{
+		saveInitPins(pinMap, bitCount, clockPin);
 		//values must be divided to fit 8bits
 		//instead of using a float, bitshift 8 bits to the right later:
 		//colorDepthConversionFactor = (colorMaxValue - colorMinValue + 1)/256;
@@ -120,6 +121,19 @@ class CompositeGrayPDM8 : public CompositeI2SEngine<BLpx1sz8sw3sh0>, public Grap
 
 	//THE REST OF THE FILE IS SHARED CODE BETWEEN ...
 
+	bool initWithSavedPins(const ModeComposite &mode)
+	override
+	{
+		return initoverlappingbuffers(mode, initPinMap, initBitCount, initClockPin);
+	}
+
+	void releaseFrameMemory(bool keepMemory)
+	override
+	{
+		releaseFrameBuffers(keepMemory);
+		currentBufferToAssign = 0;
+	}
+
 	virtual void propagateResolution(const int xres, const int yres)
 	{
 		setResolution(xres, yres);
@@ -129,7 +143,7 @@ class CompositeGrayPDM8 : public CompositeI2SEngine<BLpx1sz8sw3sh0>, public Grap
 
 	virtual BufferGraphicsUnit **allocateFrameBuffer()
 	{
-		void **arr = (void **)malloc(yres * sizeof(void *));
+		void **arr = (void **)frameBufferArena.allocate(yres * sizeof(void *), false);
 		if(!arr)
 			ERROR("Not enough memory");
 		for (int y = 0; y < yres; y++)
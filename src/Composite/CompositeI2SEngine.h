@@ -14,15 +14,19 @@
 #include "Composite.h"
 
 #include "../Tools/Log.h"
+#include "../Tools/MemoryArena.h"
+#include "../Tools/LineScheduler.h"
+#include "../Tools/DMATimeline.h"
 
 template<class BufferLayout>
 class CompositeI2SEngine : public Composite, public BufferLayout
 {
   public:
 	CompositeI2SEngine(const int i2sIndex = 0)
-	: Composite(i2sIndex)
+	: Composite(i2sIndex), dmaArena(true)
 	{
 		lineBufferCount = 1;
+		lineBatchCount = 1;
 		dmaBufferDescriptors = 0;
 		rendererBufferCount = 1;
 		rendererStaticReplicate32mask = rendererStaticReplicate32();
@@ -89,6 +93,10 @@ class CompositeI2SEngine : public Composite, public BufferLayout
 	int indexRendererEvenDataBuffer[3]; // index of the first DMA descriptor of each even field buffer
 	int indexHingeEvenDataBuffer; // last common DMA descriptor that "jumps" to the first DMA descriptor of the even field active data buffer
 
+	//members for interrupt-based (dynamic) modes
+	int lineBatchCount; // lines rendered per interrupt (only every lineBatchCount-th line raises EOF)
+	LineScheduler lineScheduler; // lines the interrupt renders
+
 	//other members
 	int baseBufferValue = 0;
 	int syncBufferValue = 0;
@@ -98,6 +106,8 @@ class CompositeI2SEngine : public Composite, public BufferLayout
 
 	int rendererStaticReplicate32mask = 0;
 
+	MemoryArena dmaArena; // active line buffers
+
 	static int bytesPerBufferUnit()
 	{
 		return sizeof(BufferRendererUnit);
@@ -125,6 +135,210 @@ class CompositeI2SEngine : public Composite, public BufferLayout
 		//return (BufferRendererUnit *) (dmaBufferDescriptors[indexRendererDataBuffer[bufferIndex] + y*mode.vDiv * descriptorsPerLine + descriptorsPerLine - 1].buffer() + dataOffsetInLineInBytes);
 	}
 
+	void setLineBatchCount(int lineBatchCount)
+	{
+		this->lineBatchCount = lineBatchCount < 1 ? 1 : lineBatchCount;
+	}
+
+	//lines the interrupt had to catch up on since init because previous interrupts were skipped
+	unsigned long getMissedLines() const
+	{
+		return lineScheduler.missedLines;
+	}
+
+	//a batch of N lines is rendered after the data descriptor of its last line is consumed,
+	//so the first line of the batch must be rendered in (lineBufferCount - N) line periods
+	void checkLineBatching()
+	{
+		int maxBatch = lineBufferCount - 1;
+		if (maxBatch < 1) maxBatch = 1;
+		if (lineBatchCount > maxBatch)
+			lineBatchCount = maxBatch;
+		if (lineBatchCount > 1 && lineBufferCount < 2 * lineBatchCount)
+		{
+			unsigned long linePeriodNs = (unsigned long)((uint64_t)mode.pixelsPerLine() * 1000000000 / mode.pixelClock);
+			DEBUG_PRINT("Line batching: ");
+			DEBUG_PRINT(lineBatchCount);
+			DEBUG_PRINT(" lines per interrupt, interrupt period (ns) ");
+			DEBUG_PRINT(linePeriodNs * lineBatchCount);
+			DEBUG_PRINT(", render slack (ns) ");
+			DEBUG_PRINTLN(linePeriodNs * (lineBufferCount - lineBatchCount));
+			DEBUG_PRINTLN("Slack is shorter than the batch: expect late lines under load, raise lineBufferCount to 2 * lineBatchCount");
+		}
+	}
+
+	//flag the last descriptor of every lineBatchCount-th line and of the last line of the frame
+	//(only the last line in the DMA-only engines, their interrupt just signals the frame)
+	//descriptors of additional renderer buffers mirror the flags of the first one
+	void markInterruptDescriptors()
+	{
+		checkLineBatching();
+		int linesTotal = mode.linesPerFrame;
+		//there is no render task asking for a deeper window, it spans all the line buffers
+		lineScheduler.start(linesTotal, lineBatchCount, lineBufferCount, lineBufferCount);
+		if (frameInterruptOnly())
+		{
+			//only the end of the frame, whatever buffer is shown (merged lines do not tell their line from the index)
+			for (int i = 0; i < dmaBufferDescriptorCount; i++)
+				dmaBufferDescriptors[i].setEOF(false);
+			for (int b = 0; b < rendererBufferCount; b++)
+				dmaBufferDescriptors[(mode.interlaced ? indexRendererEvenDataBuffer[b] : indexRendererDataBuffer[b]) + mode.vActive * descriptorsPerLine - 1].setEOF(true);
+		}
+		else
+			for (int i = 0; i < dmaBufferDescriptorCount; i++)
+			{
+				int d = i;
+				if (d >= linesTotal * descriptorsPerLine)
+					d = indexRendererDataBuffer[0] + (d - linesTotal * descriptorsPerLine) % (mode.vActive * descriptorsPerLine);
+				int line = d / descriptorsPerLine;
+				bool lastOfLine = (d % descriptorsPerLine) == descriptorsPerLine - 1;
+				dmaBufferDescriptors[i].setEOF(lastOfLine && (((line + 1) % lineBatchCount) == 0 || line == linesTotal - 1));
+			}
+#ifdef I2S_INTERRUPT_STATS
+		setInterruptStatsTiming(lineBatchCount * descriptorsPerLine, descriptorsPerLine, linesTotal * descriptorsPerLine,
+			(long)((uint64_t)mode.pixelsPerLine() * 1000000000 / mode.pixelClock), lineBufferCount - lineBatchCount);
+#endif
+	}
+
+	//the interrupt of the interrupt driven engines: converts every line not rendered yet
+	//pixelLine gets the frame buffer row, the whole DMA line buffer and the line of the frame
+	//rows is the number of rows pixelLine accepts
+	//repeated lines copy the line linesAbove lines up (2 where consecutive lines differ, as in PAL color)
+	__attribute__((always_inline)) inline void renderScheduledLines(void (*pixelLine)(int y, uint8_t *line, void *arg, int renderLine), void *arg, int rows, int linesAbove = 1)
+	{
+		//obtain the line just finished from the buffer just read, based on the conventioned ordering and buffers per line
+		//only the last (data) descriptor of every lineBatchCount-th line raises EOF, so there is one interrupt per batch
+		currentLine = dmaBufferDescriptorActive >> ( (descriptorsPerLine==2) ? 1 : 0 );
+
+		lineScheduler.schedule(currentLine);
+
+		//TO DO: This should be precalculated outside the interrupt
+		int oddFieldStart = mode.vFront + mode.vOddFieldOffset + mode.vBack;
+		int evenFieldStart = mode.vFront + mode.vEvenFieldOffset + mode.vBack;
+
+		for (int i = 0; i < lineScheduler.pendingLines; i++)
+		{
+			int renderLine = lineScheduler.line(i);
+
+			//line of the field and frame buffer row
+			int renderActiveLine = -1;
+			int y = 0;
+			if (!mode.interlaced)
+			{
+				if (renderLine >= oddFieldStart)
+				{
+					renderActiveLine = renderLine - oddFieldStart;
+					y = renderActiveLine / mode.vDiv;
+				}
+			}
+			else if (renderLine >= oddFieldStart && renderLine < oddFieldStart + mode.vActive)
+			{
+				renderActiveLine = renderLine - oddFieldStart;
+				y = 2*renderActiveLine / mode.vDiv;
+			}
+			else if (renderLine >= evenFieldStart && renderLine < evenFieldStart + mode.vActive)
+			{
+				renderActiveLine = renderLine - evenFieldStart;
+				y = (2*renderActiveLine + 1) / mode.vDiv;
+			}
+
+			if (renderActiveLine >= 0)
+			{
+				DMABufferDescriptor *renderDescriptor = &dmaBufferDescriptors[renderLine * descriptorsPerLine + descriptorsPerLine - 1];
+				if (lineScheduler.repeats(i) && renderActiveLine >= linesAbove)
+					renderDescriptor->copyBufferFrom(*(renderDescriptor - linesAbove * descriptorsPerLine));
+				else if (y >= 0 && y < rows)
+					pixelLine(y, (uint8_t *)renderDescriptor->buffer(), arg, renderLine);
+			}
+
+			if (renderLine == 0)
+			{
+				vSyncPassed = true;
+				FrameSync::signalFromISR(&frameSync, currentLine);
+			}
+		}
+		lineScheduler.finish();
+	}
+
+	// Lifecycle: the pins of the last init are kept for reinit
+
+	static const int maxInitPins = 24;
+	int initPinMap[maxInitPins];
+	int initBitCount = 0;
+	int initClockPin = -1;
+
+	void saveInitPins(const int *pinMap, const int bitCount, const int clockPin)
+	{
+		if (pinMap != initPinMap)
+			for (int i = 0; i < bitCount && i < maxInitPins; i++)
+				initPinMap[i] = pinMap[i];
+		initBitCount = bitCount;
+		initClockPin = clockPin;
+	}
+
+	//stops the output and frees every buffer, init can be called again afterwards
+	void deinit()
+	{
+		stopOutput();
+		releaseFrameMemory(false);
+		dmaArena.release();
+	}
+
+	//switches to another mode on the pins of the last init
+	//the memory blocks of the current mode are reused as far as the new one fits in them
+	//the blocks it leaves unused are freed, a mode needing much less than the kept blocks starts over with new ones
+	bool reinit(const ModeComposite &mode)
+	{
+		if (!initBitCount)
+			return false;
+		stopOutput();
+		releaseFrameMemory(true);
+		dmaArena.reset();
+		if (!initWithSavedPins(mode))
+			return false;
+		dmaArena.trim();
+		if (!dmaArena.oversized() && !frameMemoryOversized())
+			return true;
+		stopOutput();
+		releaseFrameMemory(false);
+		dmaArena.release();
+		return initWithSavedPins(mode);
+	}
+
+	void stopOutput()
+	{
+		if (!dmaBufferDescriptors)
+			return;
+		i2sStop();
+		dmaBufferDescriptors = 0;
+		dmaBufferDescriptorCount = 0;
+	}
+
+	//frame buffers and tables allocated outside the engine (keepMemory leaves the blocks for the next init)
+	virtual void releaseFrameMemory(bool /*keepMemory*/)
+	{
+	}
+
+	//the frame memory kept by the last reinit is mostly spare (the frame buffer arena is trimmed by setResolution)
+	virtual bool frameMemoryOversized()
+	{
+		return false;
+	}
+
+	//repeats the last init with another mode
+	virtual bool initWithSavedPins(const ModeComposite &mode)
+	{
+		return initengine(mode, initPinMap, initBitCount, initClockPin, descriptorsPerLine);
+	}
+
+	void *allocateDMA(int bytes, bool clear = true)
+	{
+		void *b = dmaArena.allocate(bytes, clear);
+		if (!b)
+			ERROR("Not enough DMA memory");
+		return b;
+	}
+
 	void switchToRendererBuffer(int bufferNumber)
 	{
 		//THIS MUST BE FIXED FOR INTERLACED MODES
@@ -159,6 +373,100 @@ class CompositeI2SEngine : public Composite, public BufferLayout
 		DEBUG_PRINTLN("");
 	}
 
+	//prototypes of the composite timelines: a whole normal line and the half lines of the vertical sync
+	//NF, NB, EQ, SY (NormalFront, NormalBack, Equalizing, Sync)
+	enum
+	{
+		timelineNormal = 0,
+		timelineNormalFront = 1,
+		timelineNormalBack = 2,
+		timelineEqualizing = 3,
+		timelineVSync = 4
+	};
+	typedef DMATimeline<24, 5> Timeline;
+
+	//one field: vFront, the equalizing and sync half lines between the regular half lines, vBack and the active lines
+	void addFieldToTimeline(Timeline &timeline, int preRegHL, int postRegHL, bool mergeable)
+	{
+		timeline.add(timelineNormal, mode.vFront + preRegHL / 2, mergeable);
+		timeline.addHalfLines(timelineNormalFront, preRegHL & 1);
+		timeline.addHalfLines(timelineEqualizing, mode.vPreEqHL);
+		timeline.addHalfLines(timelineVSync, mode.vSyncHL);
+		timeline.addHalfLines(timelineEqualizing, mode.vPostEqHL);
+		timeline.addHalfLines(timelineNormalBack, postRegHL & 1);
+		timeline.add(timelineNormal, postRegHL / 2 + mode.vBack, mergeable);
+		timeline.addData(mode.vActive);
+	}
+
+	//the odd field, the even field (interlaced), then the odd and even fields of the additional buffers
+	void buildTimeline(Timeline &timeline, bool mergeable)
+	{
+		addFieldToTimeline(timeline, mode.vOPreRegHL, mode.vOPostRegHL, mergeable);
+		if (mode.interlaced)
+			addFieldToTimeline(timeline, mode.vEPreRegHL, mode.vEPostRegHL, mergeable);
+		for (int f = mode.interlaced ? 2 : 1; f > 0; f--)
+			for (int b = 1; b < rendererBufferCount; b++)
+				timeline.addData(mode.vActive);
+	}
+
+	//renderer buffer and field (1 for the even one) of the data run of the timeline
+	void dataRunBuffer(int run, int &b, int &field)
+	{
+		if (!mode.interlaced)
+		{
+			b = run;
+			field = 0;
+		}
+		else if (run < 2)
+		{
+			b = 0;
+			field = run;
+		}
+		else if (run <= rendererBufferCount)
+		{
+			b = run - 1;
+			field = 0;
+		}
+		else
+		{
+			b = run - rendererBufferCount;
+			field = 1;
+		}
+	}
+
+	//records the position of the first descriptor of a data run and closes the ring after the run
+	//WARNING: FOR INTERLACED MODES THERE ARE TWO BIFURCATIONS AND TWO REENTRY POINTS
+	//even fields go back to the start, odd ones land on the descriptor after the odd field of the first buffer
+	void placeDataRun(int run, int d)
+	{
+		int b, field;
+		dataRunBuffer(run, b, field);
+		if (field)
+		{
+			indexRendererEvenDataBuffer[b] = d;
+			dmaBufferDescriptors[d + mode.vActive * descriptorsPerLine - 1].next(dmaBufferDescriptors[0]);
+			if (!b)
+				indexHingeEvenDataBuffer = d - 1;
+			return;
+		}
+		indexRendererDataBuffer[b] = d;
+		if (!b)
+		{
+			indexHingeDataBuffer = d - 1;
+			indexHingeEvenDataBuffer = d - 1;
+			indexLandingFromOddDataBuffer = mode.interlaced ? d + mode.vActive * descriptorsPerLine : 0;
+		}
+		dmaBufferDescriptors[d + mode.vActive * descriptorsPerLine - 1].next(dmaBufferDescriptors[indexLandingFromOddDataBuffer]);
+	}
+
+	//frame buffer row of an active line of the field
+	int dataRunRow(int field, int i) const
+	{
+		if (field)
+			return (i * 2 + 1) / mode.vDiv;
+		return (i * (mode.interlaced ? 2 : 1)) / mode.vDiv;
+	}
+
 	//complete ringbuffer for frame
 	void allocateRendererBuffers2DescriptorsPerLine()
 	{
@@ -173,10 +481,7 @@ class CompositeI2SEngine : public Composite, public BufferLayout
 		// Line must have an even number of samples
 
 
-		int sizeHLineComplete = samplesHLineComplete * bytesPerBufferUnit()/samplesPerBufferUnit();
-		int sizeHLineCompleteAligned32 = (sizeHLineComplete + 3) & 0xfffffffc;
 		int sizeHBlanking = samplesHBlanking * bytesPerBufferUnit()/samplesPerBufferUnit();
-		int sizeHBlankingAligned32 = (sizeHBlanking + 3) & 0xfffffffc;
 		int sizeHData = samplesHData * bytesPerBufferUnit()/samplesPerBufferUnit();
 		int sizeHDataAligned32 = (sizeHData + 3) & 0xfffffffc;
 		//int sizeHLineBundledCompleteAligned32 = sizeHBlankingAligned32 + sizeHDataAligned32;
@@ -186,46 +491,23 @@ class CompositeI2SEngine : public Composite, public BufferLayout
 		dataOffsetInLineInBytes = 0;
 
 		//videolines and data videolines for each frame
-		int linesTotal = mode.linesPerFrame; // this accounts for interlaced frames (2 fields)
 		int dataLinesBufferCount = lineBufferCount;
 
+		//the parts of a normal line go out with one descriptor unless the interrupt derives the line from the descriptor
+		//(NF and NB are then back to back, so the half line has to keep the word alignment)
+		bool mergeNormal = frameInterruptOnly() && (sizeHalfLine & 3) == 0 && Timeline::mergeableLine(2 * sizeHalfLine);
+		Timeline timeline;
+		buildTimeline(timeline, mergeNormal);
+
 		//calculate DMA buffer descriptors needed
-		dmaBufferDescriptorCount = linesTotal * descriptorsPerLine;
-		//account for more descriptors for additional backbuffers
-		if (rendererBufferCount > 1) dmaBufferDescriptorCount += (rendererBufferCount - 1) * mode.vRes * descriptorsPerLine;
+		dmaBufferDescriptorCount = timeline.compile(descriptorsPerLine);
+		if (dmaBufferDescriptorCount < 0)
+			ERROR("Half lines of the vertical sync do not pair up");
 		//allocate DMA buffer descriptors for the whole frame
-		dmaBufferDescriptors = DMABufferDescriptor::allocateDescriptors(dmaBufferDescriptorCount);
+		dmaBufferDescriptors = DMABufferDescriptor::allocateDescriptors(dmaBufferDescriptorCount, dmaArena);
 		//link all buffer descriptors in a ring
 		for (int i = 0; i < dmaBufferDescriptorCount; i++)
 			dmaBufferDescriptors[i].next(dmaBufferDescriptors[(i + 1) % dmaBufferDescriptorCount]);
-		//
-		//IMPLEMENTATION FOR MULTIPLE BUFFERS
-		//WARNING: FOR INTERLACED MODES THERE ARE TWO BIFURCATIONS AND TWO REENTRY POINTS
-		//THIS MAY BE COMPLEX TO IMPLEMENT - CURRENLY EXPERIMENTAL
-		//
-		//close the ring at the appropriate descriptors in case there are additional backbuffers
-		//and record the position of descriptors for the data part of the buffer
-		//even additional data buffer descriptors will be located after odd additional data buffer descriptors
-		indexLandingFromOddDataBuffer = mode.interlaced?((mode.vFront + mode.vOddFieldOffset + mode.vBack + mode.vActive) * descriptorsPerLine):0;
-		indexRendererDataBuffer[0] = (mode.vFront + mode.vOddFieldOffset + mode.vBack) * descriptorsPerLine + 0 * mode.vActive * descriptorsPerLine;
-		dmaBufferDescriptors[indexRendererDataBuffer[0] + mode.vActive * descriptorsPerLine - 1].next(dmaBufferDescriptors[indexLandingFromOddDataBuffer]);
-		if(mode.interlaced)
-		{
-			indexRendererEvenDataBuffer[0] = (mode.vFront + mode.vEvenFieldOffset + mode.vBack) * descriptorsPerLine + 0 * mode.vActive * descriptorsPerLine;
-			dmaBufferDescriptors[indexRendererEvenDataBuffer[0] + mode.vActive * descriptorsPerLine - 1].next(dmaBufferDescriptors[0]);
-		}
-		for (int b = 1; b < rendererBufferCount; b++)
-		{
-			indexRendererDataBuffer[b] = linesTotal * descriptorsPerLine + (b - 1) * mode.vActive * descriptorsPerLine;
-			dmaBufferDescriptors[indexRendererDataBuffer[b] + mode.vActive * descriptorsPerLine - 1].next(dmaBufferDescriptors[indexLandingFromOddDataBuffer]);
-			if(mode.interlaced)
-			{
-				indexRendererEvenDataBuffer[b] = linesTotal * descriptorsPerLine + (rendererBufferCount - 1 + (b - 1)) * mode.vActive * descriptorsPerLine;
-				dmaBufferDescriptors[indexRendererEvenDataBuffer[b] + mode.vActive * descriptorsPerLine - 1].next(dmaBufferDescriptors[0]);
-			}
-		}
-		indexHingeDataBuffer = (mode.vFront + mode.vOddFieldOffset + mode.vBack) * descriptorsPerLine - 1;
-		indexHingeEvenDataBuffer = (mode.vFront + mode.vEvenFieldOffset + mode.vBack) * descriptorsPerLine - 1;
 
 
 
@@ -247,22 +529,30 @@ class CompositeI2SEngine : public Composite, public BufferLayout
 		//create the buffers
 		//1 blank prototype line for vFront and vBack
 		//vBlankingHBlankingBuffer = DMABufferDescriptor::allocateBuffer(sizeHBlankingAligned32, true);
-		vBlankingHDataBuffer = DMABufferDescriptor::allocateBuffer(sizeHDataAligned32, true);
+		vBlankingHDataBuffer = allocateDMA(sizeHDataAligned32);
 		//1 prototype for each HL type in vSync
-		equalizingHalfLineBuffer = DMABufferDescriptor::allocateBuffer(sizeHalfLineAligned32, true);
-		vSyncHalfLineBuffer = DMABufferDescriptor::allocateBuffer(sizeHalfLineAligned32, true);
-		normalFrontHalfLineBuffer = DMABufferDescriptor::allocateBuffer(sizeHalfLineAligned32, true);
-		normalBackHalfLineBuffer = DMABufferDescriptor::allocateBuffer(sizeHalfLineAligned32, true);
+		equalizingHalfLineBuffer = allocateDMA(sizeHalfLineAligned32);
+		vSyncHalfLineBuffer = allocateDMA(sizeHalfLineAligned32);
+		if (mergeNormal)
+		{
+			//back to back, the normal line can also be sent whole
+			normalFrontHalfLineBuffer = allocateDMA(2 * sizeHalfLine);
+			normalBackHalfLineBuffer = (uint8_t *)normalFrontHalfLineBuffer + sizeHalfLine;
+		}
+		else
+		{
+			normalFrontHalfLineBuffer = allocateDMA(sizeHalfLineAligned32);
+			normalBackHalfLineBuffer = allocateDMA(sizeHalfLineAligned32);
+		}
 		//overlapping buffers for space saving
 		//vBlankingHBlankingBuffer = normalFrontHalfLineBuffer;
 		//normalBackHalfLineBuffer = vBlankingHDataBuffer;
 		//n lines as buffer for data lines
 		//allocated elsewhere (actually below)
 		DataBuffer = (void **)malloc(rendererBufferCount * dataLinesBufferCount * sizeof(void *));
-		for (int i = 0; i < rendererBufferCount * dataLinesBufferCount; i++)
-		{
-			DataBuffer[i] = DMABufferDescriptor::allocateBuffer(sizeHDataAligned32, true);
-		}
+		//the lines are carved from a few large DMA blocks
+		if (!dmaArena.allocateRows(DataBuffer, rendererBufferCount * dataLinesBufferCount, sizeHDataAligned32))
+			ERROR("Not enough DMA memory");
 		//create a live-refill buffer (when dataLinesBufferCount != mode.vRes/mode.vDiv)
 		// or create a whole buffer, but duplicating lines according to vDiv
 
@@ -356,151 +646,45 @@ class CompositeI2SEngine : public Composite, public BufferLayout
 		//assign the buffers accross the DMA buffer descriptors
 		//CONVENTION: the frame starts after the last active line of previous frame
 		//CONVENTION: the line starts after the last active (data) sample of previous line
-		int d = 0;
-		for (int i = 0; i < mode.vFront; i++)
-		{
-			dmaBufferDescriptors[d++].setBuffer(normalFrontHalfLineBuffer, sizeHalfLine);
-			dmaBufferDescriptors[d++].setBuffer(normalBackHalfLineBuffer, sizeHalfLine);
-		}
-		//pre-line
-		int consumelines = mode.vOPreRegHL;
-		while(consumelines>=2)
-		{
-			dmaBufferDescriptors[d++].setBuffer(normalFrontHalfLineBuffer, sizeHalfLine);
-			dmaBufferDescriptors[d++].setBuffer(normalBackHalfLineBuffer, sizeHalfLine);
-			consumelines-=2;
-		}
-		//NF
-		if(consumelines == 1)
-		{
-			dmaBufferDescriptors[d++].setBuffer(normalFrontHalfLineBuffer, sizeHalfLine);
-		}
-		//EQ
-		consumelines = mode.vPreEqHL;
-		for (int i = 0; i < consumelines; i++)
-			dmaBufferDescriptors[d++].setBuffer(equalizingHalfLineBuffer, sizeHalfLine);
-		//SY
-		consumelines = mode.vSyncHL;
-		for (int i = 0; i < consumelines; i++)
-			dmaBufferDescriptors[d++].setBuffer(vSyncHalfLineBuffer, sizeHalfLine);
-		//EQ
-		consumelines = mode.vPostEqHL;
-		for (int i = 0; i < consumelines; i++)
-			dmaBufferDescriptors[d++].setBuffer(equalizingHalfLineBuffer, sizeHalfLine);
-		//NB
-		consumelines = mode.vOPostRegHL;
-		if((consumelines & 1) == 1)
-		{
-			dmaBufferDescriptors[d++].setBuffer(normalBackHalfLineBuffer, sizeHalfLine);
-			consumelines--;
-		}
-		//post-line
-		while(consumelines>=2)
+		//the timeline is compiled in chunks, the descriptions of a whole frame would take a lot of memory
+		void *halfLineBuffer[5] = {normalFrontHalfLineBuffer, normalFrontHalfLineBuffer, normalBackHalfLineBuffer, equalizingHalfLineBuffer, vSyncHalfLineBuffer};
+		TimelineDescriptor chunk[32];
+		for (int first = 0; first < dmaBufferDescriptorCount; first += 32)
 		{
-			dmaBufferDescriptors[d++].setBuffer(normalFrontHalfLineBuffer, sizeHalfLine);
-			dmaBufferDescriptors[d++].setBuffer(normalBackHalfLineBuffer, sizeHalfLine);
-			consumelines-=2;
-		}
-
-		for (int i = 0; i < mode.vBack; i++)
-		{
-			dmaBufferDescriptors[d++].setBuffer(normalFrontHalfLineBuffer, sizeHalfLine);
-			dmaBufferDescriptors[d++].setBuffer(normalBackHalfLineBuffer, sizeHalfLine);
-		}
-		// for (int b = 0; b < rendererBufferCount; b++)
-		for (int i = 0; i < mode.vActive; i++)
-		{
-			dmaBufferDescriptors[d++].setBuffer(normalFrontHalfLineBuffer, sizeHBlanking);
-			int b = 0; // multiple buffers do not work at the moment
-			dmaBufferDescriptors[d++].setBuffer(DataBuffer[b * dataLinesBufferCount + ((i*(mode.interlaced?2:1)) / mode.vDiv) % dataLinesBufferCount], sizeHData);
-		}
-
-		// here d should be linesPerFrame*2 if mode is progressive
-		// and linesPerFrame*2 / 2 if mode is interlaced
-		if(mode.interlaced)
-		{
-
-		for (int i = 0; i < mode.vFront; i++)
-		{
-			dmaBufferDescriptors[d++].setBuffer(normalFrontHalfLineBuffer, sizeHalfLine);
-			dmaBufferDescriptors[d++].setBuffer(normalBackHalfLineBuffer, sizeHalfLine);
-		}
-		//pre-line
-		int consumelines = mode.vEPreRegHL;
-		while(consumelines>=2)
-		{
-			dmaBufferDescriptors[d++].setBuffer(normalFrontHalfLineBuffer, sizeHalfLine);
-			dmaBufferDescriptors[d++].setBuffer(normalBackHalfLineBuffer, sizeHalfLine);
-			consumelines-=2;
-		}
-		//NF
-		if(consumelines == 1)
-		{
-			dmaBufferDescriptors[d++].setBuffer(normalFrontHalfLineBuffer, sizeHalfLine);
-		}
-		//EQ
-		consumelines = mode.vPreEqHL;
-		for (int i = 0; i < consumelines; i++)
-			dmaBufferDescriptors[d++].setBuffer(equalizingHalfLineBuffer, sizeHalfLine);
-		//SY
-		consumelines = mode.vSyncHL;
-		for (int i = 0; i < consumelines; i++)
-			dmaBufferDescriptors[d++].setBuffer(vSyncHalfLineBuffer, sizeHalfLine);
-		//EQ
-		consumelines = mode.vPostEqHL;
-		for (int i = 0; i < consumelines; i++)
-			dmaBufferDescriptors[d++].setBuffer(equalizingHalfLineBuffer, sizeHalfLine);
-		//NB
-		consumelines = mode.vEPostRegHL;
-		if((consumelines & 1) == 1)
-		{
-			dmaBufferDescriptors[d++].setBuffer(normalBackHalfLineBuffer, sizeHalfLine);
-			consumelines--;
-		}
-		//post-line
-		while(consumelines>=2)
-		{
-			dmaBufferDescriptors[d++].setBuffer(normalFrontHalfLineBuffer, sizeHalfLine);
-			dmaBufferDescriptors[d++].setBuffer(normalBackHalfLineBuffer, sizeHalfLine);
-			consumelines-=2;
-		}
-
-		for (int i = 0; i < mode.vBack; i++)
-		{
-			dmaBufferDescriptors[d++].setBuffer(normalFrontHalfLineBuffer, sizeHalfLine);
-			dmaBufferDescriptors[d++].setBuffer(normalBackHalfLineBuffer, sizeHalfLine);
-		}
-		// for (int b = 0; b < rendererBufferCount; b++)
-		for (int i = 0; i < mode.vActive; i++)
-		{
-			dmaBufferDescriptors[d++].setBuffer(normalFrontHalfLineBuffer, sizeHBlanking);
-			int b = 0; // multiple buffers do not work at the moment
-			dmaBufferDescriptors[d++].setBuffer(DataBuffer[b * dataLinesBufferCount + ((i*2 + 1) / mode.vDiv) % dataLinesBufferCount], sizeHData);
-		}
-
-		}
-
-		//assign additional (or odd field) buffers
-		for (int b = 1; b < rendererBufferCount; b++)
-		{
-			for (int i = 0; i < mode.vActive; i++)
+			timeline.compile(descriptorsPerLine, chunk, 32, first);
+			for (int d = first; d < dmaBufferDescriptorCount && d < first + 32; d++)
 			{
-				dmaBufferDescriptors[d++].setBuffer(normalFrontHalfLineBuffer, sizeHBlanking);
-				dmaBufferDescriptors[d++].setBuffer(DataBuffer[b * dataLinesBufferCount + ((i*(mode.interlaced?2:1)) / mode.vDiv) % dataLinesBufferCount], sizeHData);
+				TimelineDescriptor &t = chunk[d - first];
+				if (t.segment == TimelineData)
+				{
+					int run = t.line / mode.vActive;
+					int i = t.line % mode.vActive;
+					if (t.part == 0)
+					{
+						if (i == 0)
+							placeDataRun(run, d);
+						dmaBufferDescriptors[d].setBuffer(normalFrontHalfLineBuffer, sizeHBlanking);
+					}
+					else
+					{
+						int b, field;
+						dataRunBuffer(run, b, field);
+						dmaBufferDescriptors[d].setBuffer(DataBuffer[b * dataLinesBufferCount + dataRunRow(field, i) % dataLinesBufferCount], sizeHData);
+					}
+				}
+				else if (t.segment == TimelineLines)
+				{
+					if (t.part < 0)
+						dmaBufferDescriptors[d].setBuffer(normalFrontHalfLineBuffer, 2 * sizeHalfLine);
+					else
+						dmaBufferDescriptors[d].setBuffer(t.part ? normalBackHalfLineBuffer : normalFrontHalfLineBuffer, sizeHalfLine);
+				}
+				else
+					dmaBufferDescriptors[d].setBuffer(halfLineBuffer[t.prototype], sizeHalfLine);
 			}
 		}
-		if(mode.interlaced)
-		{
-		//assign additional even field buffers
-		for (int b = 1; b < rendererBufferCount; b++)
-		{
-			for (int i = 0; i < mode.vActive; i++)
-			{
-				dmaBufferDescriptors[d++].setBuffer(normalFrontHalfLineBuffer, sizeHBlanking);
-				dmaBufferDescriptors[d++].setBuffer(DataBuffer[b * dataLinesBufferCount + ((i*2 + 1) / mode.vDiv) % dataLinesBufferCount], sizeHData);
-			}
-		}
-		}
+
+		markInterruptDescriptors();
 
 		free(DataBuffer);
 	}
@@ -513,7 +697,6 @@ class CompositeI2SEngine : public Composite, public BufferLayout
 		//lenght of each line
 		int samplesHLineComplete = mode.hFront + mode.hSync + mode.hBack + mode.hRes;
 		int samplesHBlanking = mode.hFront + mode.hSync + mode.hBack;
-		int samplesHData = mode.hRes;
 		//vsync lines
 		int samplesHalfLine = samplesHLineComplete/2;
 		// Line must have an even number of samples
@@ -528,46 +711,22 @@ class CompositeI2SEngine : public Composite, public BufferLayout
 		dataOffsetInLineInBytes = sizeHBlankingAligned32reduced;
 
 		//videolines and data videolines for each frame
-		int linesTotal = mode.linesPerFrame; // this accounts for interlaced frames (2 fields)
 		int dataLinesBufferCount = lineBufferCount;
 
+		//the half lines of the vertical sync are paired into lines
+		//(with a descriptor per line there is nothing to merge)
+		Timeline timeline;
+		buildTimeline(timeline, false);
+
 		//calculate DMA buffer descriptors needed
-		dmaBufferDescriptorCount = linesTotal * descriptorsPerLine;
-		//account for more descriptors for additional backbuffers
-		if (rendererBufferCount > 1) dmaBufferDescriptorCount += (rendererBufferCount - 1) * mode.vRes * descriptorsPerLine; // this will not work for interlaced frames (then, use only 1 buffer)
+		dmaBufferDescriptorCount = timeline.compile(descriptorsPerLine);
+		if (dmaBufferDescriptorCount < 0)
+			ERROR("Half lines of the vertical sync do not pair up");
 		//allocate DMA buffer descriptors for the whole frame
-		dmaBufferDescriptors = DMABufferDescriptor::allocateDescriptors(dmaBufferDescriptorCount);
+		dmaBufferDescriptors = DMABufferDescriptor::allocateDescriptors(dmaBufferDescriptorCount, dmaArena);
 		//link all buffer descriptors in a ring
 		for (int i = 0; i < dmaBufferDescriptorCount; i++)
 			dmaBufferDescriptors[i].next(dmaBufferDescriptors[(i + 1) % dmaBufferDescriptorCount]);
-		//
-		//IMPLEMENTATION FOR MULTIPLE BUFFERS
-		//WARNING: FOR INTERLACED MODES THERE ARE TWO BIFURCATIONS AND TWO REENTRY POINTS
-		//THIS MAY BE COMPLEX TO IMPLEMENT - CURRENLY EXPERIMENTAL
-		//
-		//close the ring at the appropriate descriptors in case there are additional backbuffers
-		//and record the position of descriptors for the data part of the buffer
-		//even additional data buffer descriptors will be located after odd additional data buffer descriptors
-		indexLandingFromOddDataBuffer = mode.interlaced?((mode.vFront + mode.vOddFieldOffset + mode.vBack + mode.vActive) * descriptorsPerLine):0;
-		indexRendererDataBuffer[0] = (mode.vFront + mode.vOddFieldOffset + mode.vBack) * descriptorsPerLine + 0 * mode.vActive * descriptorsPerLine;
-		dmaBufferDescriptors[indexRendererDataBuffer[0] + mode.vActive * descriptorsPerLine - 1].next(dmaBufferDescriptors[indexLandingFromOddDataBuffer]);
-		if(mode.interlaced)
-		{
-			indexRendererEvenDataBuffer[0] = (mode.vFront + mode.vEvenFieldOffset + mode.vBack) * descriptorsPerLine + 0 * mode.vActive * descriptorsPerLine;
-			dmaBufferDescriptors[indexRendererEvenDataBuffer[0] + mode.vActive * descriptorsPerLine - 1].next(dmaBufferDescriptors[0]);
-		}
-		for (int b = 1; b < rendererBufferCount; b++)
-		{
-			indexRendererDataBuffer[b] = linesTotal * descriptorsPerLine + (b - 1) * mode.vActive * descriptorsPerLine;
-			dmaBufferDescriptors[indexRendererDataBuffer[b] + mode.vActive * descriptorsPerLine - 1].next(dmaBufferDescriptors[indexLandingFromOddDataBuffer]);
-			if(mode.interlaced)
-			{
-				indexRendererEvenDataBuffer[b] = linesTotal * descriptorsPerLine + (rendererBufferCount - 1 + (b - 1)) * mode.vActive * descriptorsPerLine;
-				dmaBufferDescriptors[indexRendererEvenDataBuffer[b] + mode.vActive * descriptorsPerLine - 1].next(dmaBufferDescriptors[0]);
-			}
-		}
-		indexHingeDataBuffer = (mode.vFront + mode.vOddFieldOffset + mode.vBack) * descriptorsPerLine - 1;
-		indexHingeEvenDataBuffer = (mode.vFront + mode.vEvenFieldOffset + mode.vBack) * descriptorsPerLine - 1;
 
 
 
@@ -596,11 +755,11 @@ class CompositeI2SEngine : public Composite, public BufferLayout
 
 		//create the buffers
 		//1 blank prototype line for vFront and vBack
-		vBlankingLineBuffer = DMABufferDescriptor::allocateBuffer(sizeHLineCompleteAligned32, true);
+		vBlankingLineBuffer = allocateDMA(sizeHLineCompleteAligned32);
 		if(sizeHLineComplete % 8 == 0) // divisible by 8
 		{
 			//1 prototype for all vSync
-			vSyncPrototypesBuffer = DMABufferDescriptor::allocateBuffer(sizeHalfLine * 7, true);
+			vSyncPrototypesBuffer = allocateDMA(sizeHalfLine * 7);
 			normalFrontEqualizingLineBuffer = (void*)&(((uint8_t*)vSyncPrototypesBuffer)[0 * sizeHalfLine]);
 			equalizingEqualizingLineBuffer = (void*)&(((uint8_t*)vSyncPrototypesBuffer)[1 * sizeHalfLine]);
 			equalizingVSyncLineBuffer = (void*)&(((uint8_t*)vSyncPrototypesBuffer)[2 * sizeHalfLine]);
@@ -609,20 +768,19 @@ class CompositeI2SEngine : public Composite, public BufferLayout
 			equalizingNormalBackLineBuffer = (void*)&(((uint8_t*)vSyncPrototypesBuffer)[5 * sizeHalfLine]);
 		} else {
 			//1 prototype for each vSync
-			normalFrontEqualizingLineBuffer = DMABufferDescriptor::allocateBuffer(sizeHLineCompleteAligned32, true);
-			equalizingEqualizingLineBuffer = DMABufferDescriptor::allocateBuffer(sizeHLineCompleteAligned32, true);
-			equalizingVSyncLineBuffer = DMABufferDescriptor::allocateBuffer(sizeHLineCompleteAligned32, true);
-			vSyncVSyncLineBuffer = DMABufferDescriptor::allocateBuffer(sizeHLineCompleteAligned32, true);
-			vSyncEqualizingLineBuffer = DMABufferDescriptor::allocateBuffer(sizeHLineCompleteAligned32, true);
-			equalizingNormalBackLineBuffer = DMABufferDescriptor::allocateBuffer(sizeHLineCompleteAligned32, true);
+			normalFrontEqualizingLineBuffer = allocateDMA(sizeHLineCompleteAligned32);
+			equalizingEqualizingLineBuffer = allocateDMA(sizeHLineCompleteAligned32);
+			equalizingVSyncLineBuffer = allocateDMA(sizeHLineCompleteAligned32);
+			vSyncVSyncLineBuffer = allocateDMA(sizeHLineCompleteAligned32);
+			vSyncEqualizingLineBuffer = allocateDMA(sizeHLineCompleteAligned32);
+			equalizingNormalBackLineBuffer = allocateDMA(sizeHLineCompleteAligned32);
 		}
 		//n lines as buffer for active lines
 		//allocated elsewhere (actually below)
 		DataBuffer = (void **)malloc(rendererBufferCount * dataLinesBufferCount * sizeof(void *));
-		for (int i = 0; i < rendererBufferCount * dataLinesBufferCount; i++)
-		{
-			DataBuffer[i] = DMABufferDescriptor::allocateBuffer(sizeHLineCompleteAligned32, true);
-		}
+		//the lines are carved from a few large DMA blocks
+		if (!dmaArena.allocateRows(DataBuffer, rendererBufferCount * dataLinesBufferCount, sizeHLineCompleteAligned32))
+			ERROR("Not enough DMA memory");
 		//create a live-refill buffer (when dataLinesBufferCount != mode.vRes/mode.vDiv)
 		// or create a whole buffer, but duplicating lines according to vDiv
 
@@ -760,192 +918,40 @@ class CompositeI2SEngine : public Composite, public BufferLayout
 		//assign the buffers accross the DMA buffer descriptors
 		//CONVENTION: the frame starts after the last active line of previous frame
 		//CONVENTION: the line starts after the last active (data) sample of previous line
-		int d = 0;
-		for (int i = 0; i < mode.vFront; i++)
-		{
-			dmaBufferDescriptors[d++].setBuffer(vBlankingLineBuffer, sizeHLineComplete);
-		}
-		//pre-line
-		int consumelines = mode.vOPreRegHL;
-		while(consumelines>=2)
-		{
-			dmaBufferDescriptors[d++].setBuffer(vBlankingLineBuffer, sizeHLineComplete);
-			consumelines-=2;
-		}
-		//NF-EQ
-		if(consumelines == 1)
-		{
-			dmaBufferDescriptors[d++].setBuffer(normalFrontEqualizingLineBuffer, sizeHLineComplete);
-			consumelines = mode.vPreEqHL - 1;
-		} else {
-			consumelines = mode.vPreEqHL;
-		}
-		//EQ-EQ
-		while(consumelines>=2)
-		{
-			dmaBufferDescriptors[d++].setBuffer(equalizingEqualizingLineBuffer, sizeHLineComplete);
-			consumelines-=2;
-		}
-		//EQ-SY
-		if(consumelines == 1)
+		//the timeline is compiled in chunks, the descriptions of a whole frame would take a lot of memory
+		TimelineDescriptor chunk[32];
+		for (int first = 0; first < dmaBufferDescriptorCount; first += 32)
 		{
-			dmaBufferDescriptors[d++].setBuffer(equalizingVSyncLineBuffer, sizeHLineComplete);
-			consumelines = mode.vSyncHL - 1;
-		} else {
-			consumelines = mode.vSyncHL;
-		}
-		//SY-SY
-		while(consumelines>=2)
-		{
-			dmaBufferDescriptors[d++].setBuffer(vSyncVSyncLineBuffer, sizeHLineComplete);
-			consumelines-=2;
-		}
-		//SY-EQ
-		if(consumelines == 1)
-		{
-			dmaBufferDescriptors[d++].setBuffer(vSyncEqualizingLineBuffer, sizeHLineComplete);
-			consumelines = mode.vPostEqHL - 1;
-		} else {
-			consumelines = mode.vPostEqHL;
-		}
-		//EQ-EQ
-		while(consumelines>=2)
-		{
-			dmaBufferDescriptors[d++].setBuffer(equalizingEqualizingLineBuffer, sizeHLineComplete);
-			consumelines-=2;
-		}
-		//EQ-NB
-		if(consumelines == 1)
-		{
-			dmaBufferDescriptors[d++].setBuffer(equalizingNormalBackLineBuffer, sizeHLineComplete);
-			consumelines = mode.vOPostRegHL - 1;
-		} else {
-			consumelines = mode.vOPostRegHL;
-		}
-		//post-line
-		while(consumelines>=2)
-		{
-			dmaBufferDescriptors[d++].setBuffer(vBlankingLineBuffer, sizeHLineComplete);
-			consumelines-=2;
-		}
-
-		for (int i = 0; i < mode.vBack; i++)
-		{
-			dmaBufferDescriptors[d++].setBuffer(vBlankingLineBuffer, sizeHLineComplete);
-		}
-		// for (int b = 0; b < rendererBufferCount; b++)
-		for (int i = 0; i < mode.vActive; i++)
-		{
-			int b = 0; // multiple buffers do not work at the moment
-			dmaBufferDescriptors[d++].setBuffer(DataBuffer[b * dataLinesBufferCount + ((i*(mode.interlaced?2:1)) / mode.vDiv) % dataLinesBufferCount], sizeHLineComplete);
-		}
-
-		//DEBUG_PRINTLN(d);
-		// here d should be linesPerFrame if mode is progressive
-		// and ~linesPerFrame / 2 if mode is interlaced
-		if(mode.interlaced)
-		{
-
-		for (int i = 0; i < mode.vFront; i++)
-		{
-			dmaBufferDescriptors[d++].setBuffer(vBlankingLineBuffer, sizeHLineComplete);
-		}
-		//pre-line
-		int consumelines = mode.vEPreRegHL;
-		while(consumelines>=2)
-		{
-			dmaBufferDescriptors[d++].setBuffer(vBlankingLineBuffer, sizeHLineComplete);
-			consumelines-=2;
-		}
-		//NF-EQ
-		if(consumelines == 1)
-		{
-			dmaBufferDescriptors[d++].setBuffer(normalFrontEqualizingLineBuffer, sizeHLineComplete);
-			consumelines = mode.vPreEqHL - 1;
-		} else {
-			consumelines = mode.vPreEqHL;
-		}
-		//EQ-EQ
-		while(consumelines>=2)
-		{
-			dmaBufferDescriptors[d++].setBuffer(equalizingEqualizingLineBuffer, sizeHLineComplete);
-			consumelines-=2;
-		}
-		//EQ-SY
-		if(consumelines == 1)
-		{
-			dmaBufferDescriptors[d++].setBuffer(equalizingVSyncLineBuffer, sizeHLineComplete);
-			consumelines = mode.vSyncHL - 1;
-		} else {
-			consumelines = mode.vSyncHL;
-		}
-		//SY-SY
-		while(consumelines>=2)
-		{
-			dmaBufferDescriptors[d++].setBuffer(vSyncVSyncLineBuffer, sizeHLineComplete);
-			consumelines-=2;
-		}
-		//SY-EQ
-		if(consumelines == 1)
-		{
-			dmaBufferDescriptors[d++].setBuffer(vSyncEqualizingLineBuffer, sizeHLineComplete);
-			consumelines = mode.vPostEqHL - 1;
-		} else {
-			consumelines = mode.vPostEqHL;
-		}
-		//EQ-EQ
-		while(consumelines>=2)
-		{
-			dmaBufferDescriptors[d++].setBuffer(equalizingEqualizingLineBuffer, sizeHLineComplete);
-			consumelines-=2;
-		}
-		//EQ-NB
-		if(consumelines == 1)
-		{
-			dmaBufferDescriptors[d++].setBuffer(equalizingNormalBackLineBuffer, sizeHLineComplete);
-			consumelines = mode.vEPostRegHL - 1;
-		} else {
-			consumelines = mode.vEPostRegHL;
-		}
-		//post-line
-		while(consumelines>=2)
-		{
-			dmaBufferDescriptors[d++].setBuffer(vBlankingLineBuffer, sizeHLineComplete);
-			consumelines-=2;
-		}
-
-		for (int i = 0; i < mode.vBack; i++)
-		{
-			dmaBufferDescriptors[d++].setBuffer(vBlankingLineBuffer, sizeHLineComplete);
-		}
-		// for (int b = 0; b < rendererBufferCount; b++)
-		for (int i = 0; i < mode.vActive; i++)
-		{
-			int b = 0; // multiple buffers do not work at the moment
-			dmaBufferDescriptors[d++].setBuffer(DataBuffer[b * dataLinesBufferCount + ((i*2 + 1) / mode.vDiv) % dataLinesBufferCount], sizeHLineComplete);
-		}
-
-		}
-
-		//assign additional (or odd field) buffers
-		for (int b = 1; b < rendererBufferCount; b++)
-		{
-			for (int i = 0; i < mode.vActive; i++)
+			timeline.compile(descriptorsPerLine, chunk, 32, first);
+			for (int d = first; d < dmaBufferDescriptorCount && d < first + 32; d++)
 			{
-				dmaBufferDescriptors[d++].setBuffer(DataBuffer[b * dataLinesBufferCount + ((i*(mode.interlaced?2:1)) / mode.vDiv) % dataLinesBufferCount], sizeHLineComplete);
+				TimelineDescriptor &t = chunk[d - first];
+				void *line = vBlankingLineBuffer;
+				if (t.segment == TimelineData)
+				{
+					int run = t.line / mode.vActive;
+					int i = t.line % mode.vActive;
+					if (i == 0)
+						placeDataRun(run, d);
+					int b, field;
+					dataRunBuffer(run, b, field);
+					line = DataBuffer[b * dataLinesBufferCount + dataRunRow(field, i) % dataLinesBufferCount];
+				}
+				else if (t.segment == TimelineHalfLines)
+				{
+					//NF-EQ-EQ-SY-SY-EQ-NB
+					if (t.prototype == timelineNormalFront)
+						line = normalFrontEqualizingLineBuffer;
+					else if (t.prototype == timelineEqualizing)
+						line = t.second == timelineEqualizing ? equalizingEqualizingLineBuffer : (t.second == timelineVSync ? equalizingVSyncLineBuffer : equalizingNormalBackLineBuffer);
+					else if (t.prototype == timelineVSync)
+						line = t.second == timelineVSync ? vSyncVSyncLineBuffer : vSyncEqualizingLineBuffer;
+				}
+				dmaBufferDescriptors[d].setBuffer(line, sizeHLineComplete);
 			}
 		}
-		if(mode.interlaced)
-		{
-		//assign additional even field buffers
-		for (int b = 1; b < rendererBufferCount; b++)
-		{
-			for (int i = 0; i < mode.vActive; i++)
-			{
-				dmaBufferDescriptors[d++].setBuffer(DataBuffer[b * dataLinesBufferCount + ((i*2 + 1) / mode.vDiv) % dataLinesBufferCount], sizeHLineComplete);
-			}
-		}
-		}
+
+		markInterruptDescriptors();
 
 		free(DataBuffer);
 	}
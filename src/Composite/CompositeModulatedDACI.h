@@ -0,0 +1,289 @@
+/*
+	Author: Martin-Laclaustra 2021
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://github.com/bitluni
+*/
+
+/*
+	CONNECTION
+	
+	A) voltageDivider = false; B) voltageDivider = true
+	
+	ESP32        TV           ESP32                       TV     
+	-----+                     -----+    ____ 100 ohm
+	    G|-                        G|---|____|+          
+	pin25|--------- Comp       pin25|---|____|+--------- Comp    
+	pin26|-                    pin26|-        220 ohm
+	     |                          |
+	     |                          |
+	-----+                     -----+
+	
+	Connect pin 25 or 26
+*/
+#pragma once
+#include "CompositeI2SEngine.h"
+#include "../Graphics/BufferLayouts/BLpx1sz16sw1sh8.h"
+#include "../Graphics/ColorToBuffer/CTBComposite.h"
+
+
+//base of the DAC modes that modulate the color line by line in the interrupt (CompositeColorDACI, CompositeTextDACI)
+//it owns the DAC levels, the phase step of every pixel column and the color burst of both line parities,
+//the derived modes precalculate their output levels per phase step in modulateLevels and
+//write the active samples of a line in modulatedPixelLine, the burst is written by the interrupt here
+template<class GraphicsCombination>
+class CompositeModulatedDACI : public CompositeI2SEngine<BLpx1sz16sw1sh8>, public GraphicsCombination
+{
+  public:
+	static const int phaseStepBits = 5;
+	static const int phaseSteps = 1 << phaseStepBits;
+
+	CompositeModulatedDACI() //DAC based modes only work with I2S0
+		: CompositeI2SEngine<BLpx1sz16sw1sh8>(0)
+	{
+		//Raw DAC output values
+		modulator.levelHighClipping = 95;
+		modulator.levelWhite = 77;
+		modulator.amplitudeBurst = 11;
+		modulator.levelBlack = 23;
+		modulator.levelBlanking = 23;
+		modulator.levelLowClipping = 5;
+		modulator.levelSync = 0;
+		modulatedPixelLine = 0;
+		interruptStaticChild = &CompositeModulatedDACI::interrupt;
+	}
+
+	~CompositeModulatedDACI()
+	{
+		deinit();
+	}
+
+	int outputPin = 25;
+	bool voltageDivider = false;
+
+	bool init(const ModeComposite &mode, const int outputPin = 25, const bool voltageDivider = false)
+	{
+		const int bitCount = 16;
+		int pinMap[bitCount] = {
+			-1, -1, 
+			-1, -1, -1, -1, -1,
+			-1, -1, -1, -1, -1,
+			-1, -1, -1, -1
+		};
+		int clockPin = -1;
+		this->outputPin = outputPin;
+		this->voltageDivider = voltageDivider;
+		if(voltageDivider)
+		{
+			//Normalized (with voltage divider) DAC output values
+			modulator.levelHighClipping = 255;
+			modulator.levelWhite = 207;
+			modulator.amplitudeBurst = 31;
+			modulator.levelBlack = 62;
+			modulator.levelBlanking = 62;
+			modulator.levelLowClipping = 14;
+			modulator.levelSync = 0;
+		}
+
+		return initdynamicwritetorenderbuffer(mode, pinMap, bitCount, clockPin);
+	}
+
+	bool init(const ModeComposite &mode, const PinConfigComposite &pinConfig)
+	{
+		const int bitCount = 16;
+		int pinMap[bitCount] = {
+			-1, -1, 
+			-1, -1, -1, -1, -1,
+			-1, -1, -1, -1, -1,
+			-1, -1, -1, -1
+		};
+		int clockPin = -1;
+
+		return initdynamicwritetorenderbuffer(mode, pinMap, bitCount, clockPin);
+	}
+
+	bool initengine(const ModeComposite &mode, const int *pinMap, const int bitCount, const int clockPin = -1, int descriptorsPerLine = 2)
+	override
+	{
+		if (!initenginePreparation(mode, pinMap, bitCount, clockPin, descriptorsPerLine))
+			return false;
+		if (!initModulation())
+			return false;
+		initParallelOutputMode(pinMap, mode.pixelClock, bitCount, clockPin);
+		enableDAC(outputPin==25?1:2);
+		startTX();
+		return true;
+	}
+
+	bool initdynamicwritetorenderbuffer(const ModeComposite &mode, const int *pinMap, const int bitCount, const int clockPin = -1)
+	{
+		saveInitPins(pinMap, bitCount, clockPin);
+
+		baseBufferValue = modulator.levelBlanking;
+		syncBufferValue = modulator.levelSync;
+
+		//keep a full batch of slack ahead of the beam when several lines are rendered per interrupt
+		lineBufferCount = (2 * lineBatchCount > 3) ? 2 * lineBatchCount : 3;
+		rendererBufferCount = 1;
+		return initengine(mode, pinMap, bitCount, clockPin, 1); // 1 buffer per line
+	}
+
+	bool initWithSavedPins(const ModeComposite &mode)
+	override
+	{
+		return initdynamicwritetorenderbuffer(mode, initPinMap, initBitCount, initClockPin);
+	}
+
+	void releaseFrameMemory(bool keepMemory)
+	override
+	{
+		this->releaseFrameBuffers(keepMemory);
+		if (keepMemory)
+			return;
+		free(columnPhaseStep);
+		free(burstSamples);
+		columnPhaseStep = 0;
+		burstSamples = 0;
+	}
+
+	bool frameMemoryOversized()
+	override
+	{
+		return this->frameBufferArena.oversized();
+	}
+
+	virtual void propagateResolution(const int xres, const int yres)
+	{
+		this->setResolution(xres, yres);
+	}
+
+	virtual void show(bool vSync = false)
+	{
+		if (!this->frameBufferCount)
+			return;
+		if (vSync)
+			waitForVSync();
+		GraphicsCombination::show(vSync);
+	}
+
+  protected:
+	CTBComposite modulator;
+	uint8_t *columnPhaseStep = 0; // phase step of every pixel column
+	uint8_t *burstSamples = 0; // [line parity][burst sample], 0 in gray modes
+	int lineParities = 1;
+	//writes the active samples of frame buffer row y, the arg is the one the interrupt gets
+	void (*modulatedPixelLine)(int y, uint32_t *pixels, void *arg, int parity);
+
+	//output levels of the derived mode per phase step (and line parity), called at every init after the phases are known
+	virtual bool modulateLevels() = 0;
+
+	//phases and burst, gray modes (colorClock 0) get phase step 0 everywhere and no burst
+	bool initModulation()
+	{
+		bool color = mode.colorClock != 0;
+		lineParities = (color && mode.phaseAlternating) ? 2 : 1;
+		columnPhaseStep = (uint8_t *)realloc(columnPhaseStep, mode.hRes);
+		if (!columnPhaseStep)
+		{
+			ERROR("Not enough memory for the modulation tables");
+			return false;
+		}
+		if (!color)
+		{
+			free(burstSamples);
+			burstSamples = 0;
+			for (int x = 0; x < mode.hRes; x++)
+				columnPhaseStep[x] = 0;
+			return modulateLevels();
+		}
+
+		modulator.bufferPhaseAlternating = mode.phaseAlternating;
+		//the data starts on a 32 bit boundary, up to one sample before hFront + hSync + hBack
+		modulator.firstPixelOffset = dataOffsetInLineInBytes / 2 - mode.hFront;
+		modulator.colorClock0x1000Periods = 0x1000L*(float)mode.pixelClock/mode.colorClock; // pixels per 0x1000 color cycles
+
+		burstSamples = (uint8_t *)realloc(burstSamples, 2 * mode.burstLength + 1);
+		if (!burstSamples)
+		{
+			ERROR("Not enough memory for the modulation tables");
+			return false;
+		}
+
+		for (int x = 0; x < mode.hRes; x++)
+			columnPhaseStep[x] = ((modulator.positionPhase(x, modulator.firstPixelOffset, modulator.colorClock0x1000Periods) + (128 >> phaseStepBits)) >> (8 - phaseStepBits)) & (phaseSteps - 1);
+
+		//same waveform CompositeColorDAC writes, phase counted from the falling edge of hSync
+		//PAL: +135 degrees on the lines where V is not inverted (odd lines of the modulator)
+		for (int parity = 0; parity < 2; parity++)
+			for (int i = 0; i < mode.burstLength; i++)
+			{
+				double burstPhase = mode.phaseAlternating ? ((parity ? 1 : -1) * PI * 3 / 4) : PI;
+				burstSamples[parity * mode.burstLength + i] = (uint8_t)(modulator.levelBlanking
+					+ sin(((double)(mode.hSync + mode.burstStart + i)/((double)mode.pixelClock/(double)mode.colorClock))*(2*PI) + burstPhase)*modulator.amplitudeBurst);
+			}
+
+		if (!modulateLevels())
+			return false;
+
+		//in PAL consecutive lines differ even if they show the same row,
+		//so with vDiv > 1 every line of the ring needs a buffer of its own
+		if (mode.vDiv > 1)
+			assignLineBuffersPerLine();
+		return true;
+	}
+
+	//the engine maps the data lines of the ring by frame buffer row, this maps them by line
+	void assignLineBuffersPerLine()
+	{
+		int fields = mode.interlaced ? 2 : 1;
+		int first[2] = {indexRendererDataBuffer[0], mode.interlaced ? indexRendererEvenDataBuffer[0] : 0};
+		//collect the distinct buffers of the ring
+		void **ring = (void **)malloc(lineBufferCount * sizeof(void *));
+		int ringCount = 0;
+		for (int i = 0; i < mode.vActive && ringCount < lineBufferCount; i++)
+		{
+			void *buffer = dmaBufferDescriptors[first[0] + i].buffer();
+			bool known = false;
+			for (int j = 0; j < ringCount; j++)
+				known = known || ring[j] == buffer;
+			if (!known)
+				ring[ringCount++] = buffer;
+		}
+		int size = dmaBufferDescriptors[first[0]].getSize();
+		for (int f = 0; f < fields; f++)
+			for (int i = 0; i < mode.vActive; i++)
+				dmaBufferDescriptors[first[f] + i].setBuffer(ring[(first[f] + i) % ringCount], size);
+		free(ring);
+	}
+
+	bool useInterrupt()
+	{ 
+		return true; 
+	};
+
+	static void IRAM_ATTR interrupt(void *arg)
+	{
+		CompositeModulatedDACI * staticthis = (CompositeModulatedDACI *)arg;
+		//repeated lines are copied from the line above with the same parity
+		staticthis->renderScheduledLines(&CompositeModulatedDACI::interruptPixelLine, arg, staticthis->mode.vRes / staticthis->mode.vDiv, staticthis->lineParities);
+	}
+
+	static void IRAM_ATTR interruptPixelLine(int y, uint8_t *line, void *arg, int renderLine)
+	{
+		CompositeModulatedDACI * staticthis = (CompositeModulatedDACI *)arg;
+		//in PAL the burst and the sign of V alternate every line of the frame
+		int parity = renderLine & (staticthis->lineParities - 1);
+		//the ring buffers are shared by lines of both parities, so the burst is written every time
+		if (staticthis->burstSamples)
+		{
+			const uint8_t *burst = &staticthis->burstSamples[parity * staticthis->mode.burstLength];
+			int burstFirst = staticthis->mode.hFront + staticthis->mode.hSync + staticthis->mode.burstStart;
+			for (int i = 0; i < staticthis->mode.burstLength; i++)
+				((uint16_t *)line)[(burstFirst + i) ^ 1] = burst[i] << 8;
+		}
+		staticthis->modulatedPixelLine(y, (uint32_t *)(line + staticthis->dataOffsetInLineInBytes), arg, parity);
+	}
+};
@@ -0,0 +1,71 @@
+/*
+	Author: Martin-Laclaustra 2021
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://github.com/bitluni
+*/
+
+/*
+	CONNECTION
+	
+	A) voltageDivider = false; B) voltageDivider = true
+	
+	ESP32        TV           ESP32                       TV     
+	-----+                     -----+    ____ 100 ohm
+	    G|-                        G|---|____|+          
+	pin25|--------- Comp       pin25|---|____|+--------- Comp    
+	pin26|-                    pin26|-        220 ohm
+	     |                          |
+	     |                          |
+	-----+                     -----+
+	
+	Connect pin 25 or 26
+*/
+
+#include <Composite/CompositeTextDACI.h>
+
+void IRAM_ATTR CompositeTextDACI::interruptPixelLine(int y, uint32_t *pixels, void *arg, int parity)
+{
+	CompositeTextDACI * staticthis = (CompositeTextDACI *)arg;
+	const Font *font = staticthis->font;
+	const int charWidth = font->charWidth;
+	const int glyphSize = charWidth * font->charHeight;
+	const unsigned char *charline = staticthis->frontBuffer[y / font->charHeight];
+	//first column of the character subline of the first glyph
+	const uint8_t *subline = &font->pixels[charWidth * (y % font->charHeight)];
+
+	const uint8_t *steps = staticthis->columnPhaseStep;
+	//read once, the colors can be changed by the main program at any time
+	const uint8_t *front = staticthis->textLevels[parity][staticthis->frontGlobalColor & (textColors - 1)];
+	const uint8_t *back = staticthis->textLevels[parity][staticthis->backGlobalColor & (textColors - 1)];
+
+	unsigned char renderchar = *charline;
+	if (!font->valid(renderchar)) renderchar = ' ';
+	const uint8_t *glyph = &subline[glyphSize * (renderchar - font->firstChar)];
+	//the next cell is fetched when its first column is needed, never past the end of the row
+	int xcolumn = 0;
+	for (int i = 0; i < staticthis->mode.hRes; i += 2)
+	{
+		if (xcolumn == charWidth)
+		{
+			xcolumn = 0;
+			renderchar = *++charline;
+			if (!font->valid(renderchar)) renderchar = ' ';
+			glyph = &subline[glyphSize * (renderchar - font->firstChar)];
+		}
+		uint32_t level0 = (glyph[xcolumn++] & 1) ? front[steps[i]] : back[steps[i]];
+		if (xcolumn == charWidth)
+		{
+			xcolumn = 0;
+			renderchar = *++charline;
+			if (!font->valid(renderchar)) renderchar = ' ';
+			glyph = &subline[glyphSize * (renderchar - font->firstChar)];
+		}
+		uint32_t level1 = (glyph[xcolumn++] & 1) ? front[steps[i + 1]] : back[steps[i + 1]];
+		//two samples per write, the level goes to the MSByte of each
+		*pixels++ = (level1 << 8) | (level0 << 24);
+	}
+}
@@ -0,0 +1,93 @@
+/*
+	Author: Martin-Laclaustra 2021
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://github.com/bitluni
+*/
+
+/*
+	CONNECTION
+	
+	A) voltageDivider = false; B) voltageDivider = true
+	
+	ESP32        TV           ESP32                       TV     
+	-----+                     -----+    ____ 100 ohm
+	    G|-                        G|---|____|+          
+	pin25|--------- Comp       pin25|---|____|+--------- Comp    
+	pin26|-                    pin26|-        220 ohm
+	     |                          |
+	     |                          |
+	-----+                     -----+
+	
+	Connect pin 25 or 26
+*/
+#pragma once
+#include "CompositeModulatedDACI.h"
+#include "../Graphics/GraphicsTextBuffer.h"
+
+
+//text mode: the frame buffer holds one byte per character cell and the interrupt expands
+//the cells through the font straight into the line buffers, a 40x25 screen takes 1000 bytes
+//front and back colors are the 3 bit frontGlobalColor and backGlobalColor, their output levels
+//are precalculated for every subcarrier phase step (and line parity in PAL)
+//gray modes (colorClock 0) get the luma of the same 8 colors and no burst
+//the font has to be set before init
+class CompositeTextDACI : public CompositeModulatedDACI<GraphicsTextBuffer> // GraphicsTextBuffer (=) Graphics<ColorW8, BLpx1sz8sw0sh0, CTBIdentity>
+{
+  public:
+	static const int textColors = 8;
+
+	CompositeTextDACI()
+	{
+		modulatedPixelLine = &CompositeTextDACI::interruptPixelLine;
+	}
+
+	bool initenginePreparation(const ModeComposite &mode, const int *pinMap, const int bitCount, const int clockPin = -1, int descriptorsPerLine = 2)
+	override
+	{
+		if (!font)
+		{
+			ERROR("CompositeTextDACI needs a font, call setFont before init");
+			return false;
+		}
+		this->mode = mode;
+		int xres = (mode.hRes + font->charWidth - 1) / font->charWidth;
+		int yres = ((mode.vRes / mode.vDiv) + font->charHeight - 1) / font->charHeight;
+		totalLines = mode.linesPerField();
+		if(descriptorsPerLine < 1 || descriptorsPerLine > 2) ERROR("Wrong number of descriptors per line");
+		if(descriptorsPerLine == 1) allocateRendererBuffers1DescriptorsPerLine();
+		if(descriptorsPerLine == 2) allocateRendererBuffers2DescriptorsPerLine();
+		propagateResolution(xres, yres);
+		//allocateLineBuffers();
+		currentLine = 0;
+		vSyncPassed = false;
+		return true;
+	}
+
+  protected:
+	uint8_t textLevels[2][textColors][phaseSteps]; // [line parity][3 bit color][phase step]
+
+	//the output levels of the 8 text colors, gray modes only use phase step 0
+	bool modulateLevels()
+	override
+	{
+		for (int c = 0; c < textColors; c++)
+		{
+			const CTBCompositeCache::Chroma &chroma = modulator.chroma(ColorR8G8B8A8::static_RGBA(ColorR1G1B1A1X4::static_R(c), ColorR1G1B1A1X4::static_G(c), ColorR1G1B1A1X4::static_B(c)) & 0x00ffffff);
+			if (!mode.colorClock)
+			{
+				textLevels[0][c][0] = modulator.levelBlack + chroma.Y * (modulator.levelWhite - modulator.levelBlack + 1) / 256;
+				continue;
+			}
+			for (int parity = 0; parity < lineParities; parity++)
+				for (int step = 0; step < phaseSteps; step++)
+					textLevels[parity][c][step] = modulator.signal(chroma, step << (8 - phaseStepBits), parity);
+		}
+		return true;
+	}
+
+	static void interruptPixelLine(int y, uint32_t *pixels, void *arg, int parity);
+};
@@ -131,6 +131,20 @@ class ModeComposite
 		return hFront + hSync + hBack + hRes;
 	}
 
+	//interlaced modes show alternate rows of one buffer in the two fields
+	//field-doubled: both fields show the same row, the buffer only has the rows of one field
+	//(a doubled vDiv gives (2i)/vDiv == (2i+1)/vDiv for every line i of the field)
+	ModeComposite fieldDoubled() const
+	{
+		if (!interlaced)
+			return *this;
+		return ModeComposite(hFront, hSync, hBack, hRes,
+			vFront, vPreEqHL, vSyncHL, vPostEqHL, vBack, vActive,
+			vOPreRegHL, vOPostRegHL, vEPreRegHL, vEPostRegHL,
+			vDiv * 2, pixelClock,
+			burstStart, burstLength, colorClock, phaseAlternating, aspect);
+	}
+
 	ModeComposite custom(int xres, int yres, int fixedYDivider = 0) const
 	{
 		/*xres = (xres + 3) & 0xfffffffc;
@@ -15,6 +15,8 @@
 #include <VGA/VGA8BitDACI.h>
 #include <VGA/VGA1BitI.h>
 #include <VGA/VGATextI.h>
+#include <VGA/VGAAttributeTextI.h>
+#include <Tools/VideoMemoryPlanner.h>
 
 //== COMPOSITE ==
 #include <Composite/CompMode.h>
@@ -31,6 +33,8 @@
 #include <Composite/CompositeGrayPDM2.h>
 //Interrupt-based drivers
 #include <Composite/CompositeGrayDACI.h>
+#include <Composite/CompositeColorDACI.h>
+#include <Composite/CompositeTextDACI.h>
 #include <Composite/CompositeGrayLadderI.h>
 
 #include <LED/SerialLED.h>
@@ -0,0 +1,106 @@
+/*
+	Author: Martin-Laclaustra 2020
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://github.com/bitluni
+*/
+#pragma once
+
+#include "../integertrigonometry.h"
+#include "../Colors/InterfaceColors_ColorR8G8B8A8.h"
+
+//caches the expensive parts of the composite color conversion, shared by CTBComposite and CTBCompositeMemory
+//  - the chroma of the last colors used (luma, saturation and hue), keyed by the 24 bit color
+//  - the subcarrier phase of every pixel column, rebuilt when the mode timing changes
+//  - integersinaprox for all 256 phases
+//all values are the same the direct calculation gives, only the order of the work changes
+class CTBCompositeCache
+{
+	public:
+	static const int colorCacheBits = 6;
+	static const int phaseTableSize = 1024;
+
+	struct Chroma
+	{
+		uint32_t rgb;
+		uint8_t Y;
+		uint8_t sat;
+		uint8_t hue;
+	};
+
+	CTBCompositeCache()
+	{
+		for(int i = 0; i < (1 << colorCacheBits); i++)
+			chromaCache[i].rgb = 0xffffffff;
+		for(int i = 0; i < 256; i++)
+			sinTable[i] = integersinaprox(i);
+		phaseOffset = 0;
+		phasePeriods = 0;
+	}
+
+	//val has to be masked to 24 bits
+	const Chroma &chroma(uint32_t val)
+	{
+		Chroma &c = chromaCache[(val * 0x9E3779B1u) >> (32 - colorCacheBits)];
+		if(c.rgb != val)
+		{
+			// ranges 0,255
+			uint8_t r = ColorR8G8B8A8::static_R(val);
+			uint8_t g = ColorR8G8B8A8::static_G(val);
+			uint8_t b = ColorR8G8B8A8::static_B(val);
+			// Y = 0.299*r + 0.587*g + 0.114*b; // range 0,255
+			uint8_t Y = (19595L*r + 38470L*g + 7471L*b + 0x8000L)>>16;
+			// u in YUV, b_y = 0.492111*(b - Y); // range +/- 111.18
+			int32_t b_y = (int32_t)(((uint32_t)(32251L*((int32_t)b - Y) + 0x08007fffL))>>16) - 0x0800;
+			// v in YUV, r_y = 0.877283*(r - Y); // range +/- 156.82
+			int32_t r_y = (int32_t)(((uint32_t)(57494L*((int32_t)r - Y) + 0x08007fffL))>>16) - 0x0800;
+			// sat = sqrt(pow(b_y,2) + pow(r_y,2)); // range 0,192
+			// alpha max plus beta min algorithm, using alpha = 15/16 and beta = 15/32
+			c.sat = (abs(b_y) > abs(r_y)) ? (15*((abs(b_y)<<1) + abs(r_y)))>>5 : (15*(abs(b_y) + (abs(r_y)<<1)))>>5;
+			// hue_phase = fmod(atan2(r_y,b_y)+2*PI,2*PI)*256/(2*PI); // range 0,255
+			c.hue = integeratan2aprox(r_y,b_y)>>8;
+			c.Y = Y;
+			c.rgb = val;
+		}
+		return c;
+	}
+
+	// position_phase = fmod(x + firstPixelOffset,colorClockPeriod)*256/colorClockPeriod; // range 0,255
+	uint8_t positionPhase(int x, int firstPixelOffset, uint32_t colorClock0x1000Periods)
+	{
+		if(phasePeriods != colorClock0x1000Periods || phaseOffset != firstPixelOffset)
+		{
+			phasePeriods = colorClock0x1000Periods;
+			phaseOffset = firstPixelOffset;
+			for(int i = 0; i < phaseTableSize; i++)
+				phaseTable[i] = ((((i + firstPixelOffset)<<12)%colorClock0x1000Periods)<<8)/colorClock0x1000Periods;
+		}
+		if((unsigned int)x < phaseTableSize)
+			return phaseTable[x];
+		return ((((x + firstPixelOffset)<<12)%colorClock0x1000Periods)<<8)/colorClock0x1000Periods;
+	}
+
+	int8_t sin256(int32_t phase) const
+	{
+		return sinTable[phase & 0xff];
+	}
+
+	//PAL parity (sign of V) of a buffer row, counted by the lines of its field
+	//interlaced fields take alternate rows, so consecutive lines of a field still alternate
+	static int lineParity(int y, int vDiv, bool interlaced)
+	{
+		if(interlaced)
+			return ((y * vDiv) >> 1) & 1;
+		return y & 1;
+	}
+
+	protected:
+	Chroma chromaCache[1 << colorCacheBits];
+	uint8_t phaseTable[phaseTableSize];
+	int8_t sinTable[256];
+	int phaseOffset;
+	uint32_t phasePeriods;
+};
@@ -0,0 +1,67 @@
+/*
+	Author: Martin-Laclaustra 2020 based on bitluni 2019
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://github.com/bitluni
+*/
+#pragma once
+
+class ColorR3G3B2
+{
+	public:
+	typedef unsigned char Color;
+	ColorR3G3B2() {}
+
+	static const int static_colormask()
+	{
+		return 0b11111111;
+	}
+
+	static int static_R(Color c)
+	{
+		return (((int)c & 7) * 255 + 3) / 7;
+	}
+	static int static_G(Color c)
+	{
+		return (((int)(c >> 3) & 7) * 255 + 3) / 7;
+	}
+	static int static_B(Color c)
+	{
+		return (((int)(c >> 6) & 3) * 255 + 1) / 3;
+	}
+	static int static_A(Color c)
+	{
+		return 255;
+	}
+
+	static Color static_RGBA(int r, int g, int b, int a = 255)
+	{
+		return ((r >> 5) & 0b111) | ((g >> 2) & 0b111000) | (b & 0b11000000);
+	}
+
+	static Color static_colorAdd(Color colorOld, Color colorNew)
+	{
+		int c0 = colorOld;
+		int c1 = colorNew;
+		int r = (c0 & 0b111) + (c1 & 0b111);
+		if(r > 0b111) r = 0b111;
+		int g = (c0 & 0b111000) + (c1 & 0b111000);
+		if(g > 0b111000) g = 0b111000;
+		int b = (c0 & 0b11000000) + (c1 & 0b11000000);
+		if(b > 0b11000000) b = 0b11000000;
+		return r | g | b;
+	}
+
+	static Color static_colorMix(Color colorOld, Color colorNew)
+	{
+		int c0 = colorOld;
+		int c1 = colorNew;
+		int r = ((c0 & 0b111) + (c1 & 0b111)) >> 1;
+		int g = (((c0 & 0b111000) + (c1 & 0b111000)) >> 1) & 0b111000;
+		int b = (((c0 & 0b11000000) + (c1 & 0b11000000)) >> 1) & 0b11000000;
+		return r | g | b;
+	}
+};
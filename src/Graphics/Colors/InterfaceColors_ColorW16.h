@@ -0,0 +1,57 @@
+/*
+	Author: Martin-Laclaustra 2020 based on bitluni 2019
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://github.com/bitluni
+*/
+#pragma once
+
+//16 bit value without color meaning, e.g. a character cell with its attribute
+class ColorW16
+{
+	public:
+	typedef unsigned short Color;
+	ColorW16() {}
+
+	static const int static_colormask()
+	{
+		return 0xffff;
+	}
+
+	static int static_R(Color c)
+	{
+		return c >> 8;
+	}
+	static int static_G(Color c)
+	{
+		return c >> 8;
+	}
+	static int static_B(Color c)
+	{
+		return c >> 8;
+	}
+	static int static_A(Color c)
+	{
+		return 255;
+	}
+
+	static Color static_RGBA(int r, int g, int b, int a = 255)
+	{
+		// binary weigthed mean:
+		return (r * 13933 + g * 46871 + b * 4732) >> 8;
+	}
+
+	static Color static_colorAdd(Color colorOld, Color colorNew)
+	{
+		int sumColor = (int)colorOld + colorNew;
+		return (sumColor > 0xffff) ? 0xffff : sumColor;
+	}
+
+	static Color static_colorMix(Color colorOld, Color colorNew)
+	{
+		return ((int)colorOld + colorNew) >> 1;
+	}
+};
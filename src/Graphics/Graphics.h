@@ -56,6 +56,7 @@ buftocol
 #include "InterfaceColors.h"
 #include "BufferLayouts.h"
 #include "ColorToBuffer.h"
+#include "../Tools/MemoryArena.h"
 
 // Color defines the interface color, all interactions should use this
 // BufferUnit defines how the color is actually stored in memory
@@ -73,6 +74,7 @@ class Graphics: public ImageDrawer, public InterfaceColor, public BufferLayout,
 	BufferGraphicsUnit **frameBuffers[3];
 	BufferGraphicsUnit **frontBuffer;
 	BufferGraphicsUnit **backBuffer;
+	MemoryArena frameBufferArena; // rows of all frame buffers
 	bool autoScroll;
 	size_t sizeOfBufferUnit = sizeof(BufferGraphicsUnit);
 	int storageCoefficient = 1; //number of pixels in an BufferUnit variable
@@ -201,17 +203,13 @@ class Graphics: public ImageDrawer, public InterfaceColor, public BufferLayout,
 	}
 	virtual BufferGraphicsUnit** allocateFrameBuffer(int xres, int yres, BufferGraphicsUnit value)
 	{
-		BufferGraphicsUnit** frame = (BufferGraphicsUnit **)malloc(yres * sizeof(BufferGraphicsUnit *));
-		if(!frame)
+		//the rows are carved from a few large blocks (word aligned, one after the other)
+		BufferGraphicsUnit** frame = (BufferGraphicsUnit **)frameBufferArena.allocate(yres * sizeof(BufferGraphicsUnit *), false);
+		if(!frame || !frameBufferArena.allocateRows((void **)frame, yres, xres * sizeof(BufferGraphicsUnit), false))
 			ERROR("Not enough memory for frame buffer");
 		for (int y = 0; y < yres; y++)
-		{
-			frame[y] = (BufferGraphicsUnit *)malloc(xres * sizeof(BufferGraphicsUnit));
-			if(!frame[y])
-				ERROR("Not enough memory for frame buffer");
 			for (int x = 0; x < xres; x++)
 				frame[y][x] = value;
-		}
 		return frame;
 	}
 	static void **allocateRegularBufferArray(int count, int bytes)
@@ -338,11 +336,26 @@ class Graphics: public ImageDrawer, public InterfaceColor, public BufferLayout,
 		return true;
 	}
 
+	//the frame buffers are gone afterwards, keepMemory leaves their blocks for the next allocation
+	void releaseFrameBuffers(bool keepMemory = false)
+	{
+		for(int i = 0; i < 3; i++)
+			frameBuffers[i] = 0;
+		frontBuffer = 0;
+		backBuffer = 0;
+		if(keepMemory)
+			frameBufferArena.reset();
+		else
+			frameBufferArena.release();
+	}
+
 	virtual void setResolution(int xres, int yres)
 	{
 		this->xres = xres;
 		this->yres = yres;
 		allocateFrameBuffers();
+		//blocks kept from a larger mode
+		frameBufferArena.trim();
 	}
 
 	virtual float pixelAspect() const
@@ -720,7 +733,7 @@ class Graphics: public ImageDrawer, public InterfaceColor, public BufferLayout,
 		}
 	}
 
-	void fillRect(int x, int y, int w, int h, Color color)
+	virtual void fillRect(int x, int y, int w, int h, Color color)
 	{
 		if (x < 0)
 		{
@@ -884,7 +897,7 @@ class Graphics: public ImageDrawer, public InterfaceColor, public BufferLayout,
 		{
 			int i = srcX + (py + srcY) * image.xres;
 			for (int px = 0; px < srcXres; px++)
-				dot(px + x, py + y, R8G8B8A8ToColor(((unsigned long*)image.pixels)[i++]));
+				dot(px + x, py + y, R8G8B8A8ToColor(((uint32_t *)image.pixels)[i++]));
 		}		
 	}
 
@@ -894,7 +907,7 @@ class Graphics: public ImageDrawer, public InterfaceColor, public BufferLayout,
 		{
 			int i = srcX + (py + srcY) * image.xres;
 			for (int px = 0; px < srcXres; px++)
-				dotAdd(px + x, py + y, R8G8B8A8ToColor(((unsigned long*)image.pixels)[i++]));
+				dotAdd(px + x, py + y, R8G8B8A8ToColor(((uint32_t *)image.pixels)[i++]));
 		}
 	}
 
@@ -904,7 +917,7 @@ class Graphics: public ImageDrawer, public InterfaceColor, public BufferLayout,
 		{
 			int i = srcX + (py + srcY) * image.xres;
 			for (int px = 0; px < srcXres; px++)
-				dotMix(px + x, py + y, R8G8B8A8ToColor(((unsigned long*)image.pixels)[i++]));
+				dotMix(px + x, py + y, R8G8B8A8ToColor(((uint32_t *)image.pixels)[i++]));
 		}
 	}	
 
@@ -0,0 +1,98 @@
+/*
+	Author: bitluni 2019
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://youtube.com/bitlunislab
+		https://github.com/bitluni
+		http://bitluni.net
+*/
+#pragma once
+#include "Graphics.h"
+
+//text buffer with an attribute per cell
+//cell: character in the low byte, attribute in the high byte
+//attribute: foreground color in bits 0-3, background color in bits 4-7
+//(bit 7 makes the character blink instead when the renderer has blinking enabled)
+class GraphicsAttributeTextBuffer: public Graphics<ColorW16, BLpx1sz16sw0sh0, CTBIdentity>
+{
+	public:
+	//attribute of the characters printed from now on
+	unsigned char textAttribute;
+
+	GraphicsAttributeTextBuffer()
+	{
+		frontColor = 0;
+		setTextAttribute(0x07);
+		defaultBufferValue = cell(' ', 0x07);
+	}
+
+	static Color cell(int ch, int attribute)
+	{
+		return (ch & 0xff) | ((attribute & 0xff) << 8);
+	}
+
+	//fills with a whole cell, see cell()
+	virtual void clear(Color color)
+	{
+		Graphics::clear(color);
+	}
+
+	//spaces in the current attribute
+	void clear()
+	{
+		clear(cell(' ', textAttribute));
+	}
+
+	void clear(int ch, int attribute)
+	{
+		clear(cell(ch, attribute));
+	}
+
+	virtual void dotAdd(int x, int y, Color color)
+	{
+		dot(x, y, color);
+	}
+	
+	virtual void dotMix(int x, int y, Color color)
+	{
+		dot(x, y, color);
+	}
+
+	void setTextAttribute(int attribute)
+	{
+		textAttribute = attribute;
+		//scrolling fills the new line with this
+		backColor = cell(' ', textAttribute);
+	}
+
+	void setTextColor(int front, int back = 0)
+	{
+		setTextAttribute((front & 15) | ((back & 15) << 4));
+	}
+
+	void setCellAttribute(int x, int y, int attribute)
+	{
+		if (x >= 0 && x < xres && y >= 0 && y < yres)
+			dotFast(x, y, cell(getFast(x, y), attribute));
+	}
+
+	virtual void setFont(Font &font)
+	{
+		if (this->font != 0) return; // font can not be changed in this mode
+		this->font = &font;
+		cursorXIncrement = 1;
+		cursorYIncrement = 1;
+	}
+
+	virtual void drawChar(int x, int y, int ch)
+	{
+		if (!font)
+			return;
+		if (!font->valid(ch))
+			return;
+		dot(x, y, cell(ch, textAttribute));
+	}
+};
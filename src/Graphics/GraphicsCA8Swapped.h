@@ -8,9 +8,9 @@
 		https://github.com/bitluni
 */
 #pragma once
-#include "Graphics.h"
+#include "GraphicsCompositeColor.h"
 
-class GraphicsCA8Swapped: public Graphics<ColorR8G8B8A8, BLpx1sz8sw2sh0, CTBComposite>
+class GraphicsCA8Swapped: public GraphicsCompositeColor<BLpx1sz8sw2sh0, CTBComposite>
 {
 	public:
 
@@ -0,0 +1,74 @@
+/*
+	Author: Martin-Laclaustra 2020
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://github.com/bitluni
+*/
+#pragma once
+#include "Graphics.h"
+
+//common base of the composite color formats (one sample per pixel)
+//the sample of a color depends on the subcarrier phase of its column and, with PAL, on the parity of the line
+//the phase does not repeat after a whole number of pixels, but it is the same in every line,
+//so filled areas convert only their first line (a few with PAL) and copy it to the others
+template<class BufferLayout, class ColorToBuffer>
+class GraphicsCompositeColor: public Graphics<ColorR8G8B8A8, BufferLayout, ColorToBuffer>
+{
+	public:
+	typedef typename BufferLayout::BufferUnit BufferGraphicsUnit;
+	typedef typename ColorR8G8B8A8::Color Color;
+
+	virtual void clear(Color color = 0)
+	{
+		fillRect(0, 0, this->xres, this->yres, color);
+	}
+
+	virtual void fillRect(int x, int y, int w, int h, Color color)
+	{
+		if (x < 0)
+		{
+			w += x;
+			x = 0;
+		}
+		if (y < 0)
+		{
+			h += y;
+			y = 0;
+		}
+		if (x + w > this->xres)
+			w = this->xres - x;
+		if (y + h > this->yres)
+			h = this->yres - y;
+		if (w <= 0 || h <= 0)
+			return;
+		//rows repeat with the PAL line parity, every 4 rows when the fields take alternate rows
+		int sourceRows = 1;
+		if (this->bufferPhaseAlternating)
+			sourceRows = (this->bufferInterlaced && (this->bufferVDiv & 1)) ? 4 : 2;
+		if (sourceRows > h)
+			sourceRows = h;
+		for (int j = y; j < y + sourceRows; j++)
+			for (int i = x; i < x + w; i++)
+				this->dotFast(i, j, color);
+		//the units are swapped within 32 bit words, whole words are copied as they are
+		const int unitsPerWord = 4 / sizeof(BufferGraphicsUnit);
+		int wordStart = (x + unitsPerWord - 1) & ~(unitsPerWord - 1);
+		int wordEnd = (x + w) & ~(unitsPerWord - 1);
+		if (wordEnd <= wordStart)
+			wordStart = wordEnd = x + w;
+		for (int j = y + sourceRows; j < y + h; j++)
+		{
+			//the first line of the area with the same parity
+			BufferGraphicsUnit *source = this->backBuffer[y + ((j - y) & (sourceRows - 1))];
+			BufferGraphicsUnit *line = this->backBuffer[j];
+			for (int i = x; i < wordStart; i++)
+				line[BufferLayout::static_swx(i)] = source[BufferLayout::static_swx(i)];
+			memcpy(&line[wordStart], &source[wordStart], (wordEnd - wordStart) * sizeof(BufferGraphicsUnit));
+			for (int i = wordEnd; i < x + w; i++)
+				line[BufferLayout::static_swx(i)] = source[BufferLayout::static_swx(i)];
+		}
+	}
+};
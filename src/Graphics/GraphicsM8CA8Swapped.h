@@ -8,9 +8,9 @@
 		https://github.com/bitluni
 */
 #pragma once
-#include "Graphics.h"
+#include "GraphicsCompositeColor.h"
 
-class GraphicsM8CA8Swapped: public Graphics<ColorR8G8B8A8, BLpx1sz16sw1sh0, CTBCompositeMemory>
+class GraphicsM8CA8Swapped: public GraphicsCompositeColor<BLpx1sz16sw1sh0, CTBCompositeMemory>
 {
 	public:
 
@@ -0,0 +1,26 @@
+/*
+	Author: bitluni 2019
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://youtube.com/bitlunislab
+		https://github.com/bitluni
+		http://bitluni.net
+*/
+#pragma once
+#include "Graphics.h"
+
+//8 bit per pixel, used as a palette index by the palette based engines
+//the default palette of those engines is R3G3B2, so RGBA keeps working unless the palette is changed
+class GraphicsR3G3B2: public Graphics<ColorR3G3B2, BLpx1sz8sw0sh0, CTBIdentity>
+{
+	public:
+
+	GraphicsR3G3B2()
+	{
+		//TODO:decide where to move this.
+		frontColor = 0xff;
+	}
+};
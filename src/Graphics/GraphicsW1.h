@@ -35,6 +35,47 @@ class GraphicsW1: public Graphics<ColorW1X7, BLpx8sz8swyshy, CTBIdentity>
 				backBuffer[y][x] = storeWord;
 	}
 
+	//eight rows share a buffer unit, so only whole units can be rotated like in Graphics::scroll
+	virtual void scroll(int dy, Color color)
+	{
+		int rows = (yres + static_ypixperunit() - 1) / static_ypixperunit();
+		if((dy % static_ypixperunit()) == 0)
+		{
+			int du = dy / static_ypixperunit();
+			for(int d = 0; d < du; d++)
+			{
+				BufferGraphicsUnit *l = backBuffer[0];
+				for(int i = 0; i < rows - 1; i++)
+					backBuffer[i] = backBuffer[i + 1];
+				backBuffer[rows - 1] = l;
+			}
+			for(int d = 0; d < -du; d++)
+			{
+				BufferGraphicsUnit *l = backBuffer[rows - 1];
+				for(int i = rows - 1; i > 0; i--)
+					backBuffer[i] = backBuffer[i - 1];
+				backBuffer[0] = l;
+			}
+		}
+		else if(dy > 0)
+		{
+			for(int y = 0; y < yres - dy; y++)
+				for(int x = 0; x < xres; x++)
+					dotFast(x, y, getFast(x, y + dy));
+		}
+		else
+		{
+			for(int y = yres - 1; y >= -dy; y--)
+				for(int x = 0; x < xres; x++)
+					dotFast(x, y, getFast(x, y + dy));
+		}
+		if(dy > 0)
+			fillRect(0, yres - dy, xres, dy, color);
+		else if(dy < 0)
+			fillRect(0, 0, xres, -dy, color);
+		cursorY -= dy;
+	}
+
 	void setFrontGlobalColor(int r, int g, int b, int a = 255)
 	{
 		frontGlobalColor = ColorR1G1B1A1X4::static_RGBA(r, g, b, a);
@@ -0,0 +1,116 @@
+/*
+	Author: Martin-Laclaustra 2020
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://github.com/bitluni
+*/
+#pragma once
+#include "Graphics.h"
+
+//common base of the gray PDM formats (a bit pattern per pixel, several pixels per byte)
+//the pattern of a level does not depend on the position, so a 32 bit word of it is
+//precalculated for every level and spans write whole words instead of single pixels
+template<class BufferLayout, class ColorToBuffer>
+class GraphicsW8PDM: public Graphics<ColorW8, BufferLayout, ColorToBuffer>
+{
+	public:
+	typedef typename BufferLayout::BufferUnit BufferGraphicsUnit;
+	typedef typename ColorW8::Color Color;
+
+	static int pixelsPerWord()
+	{
+		return 4 / sizeof(BufferGraphicsUnit) * BufferLayout::static_xpixperunit();
+	}
+
+	GraphicsW8PDM()
+	{
+		levelWordsMinValue = -1;
+		levelWordsFactor = -1;
+	}
+
+	//a 32 bit word with every pixel set to the level
+	//rebuilt when the range of the levels changes (it is set by the engine on init)
+	uint32_t levelWord(Color color)
+	{
+		if (levelWordsMinValue != this->colorMinValue || levelWordsFactor != this->colorDepthConversionFactor)
+		{
+			levelWordsMinValue = this->colorMinValue;
+			levelWordsFactor = this->colorDepthConversionFactor;
+			for (int c = 0; c < 256; c++)
+			{
+				uint32_t word = 0;
+				BufferGraphicsUnit *units = (BufferGraphicsUnit *)&word;
+				int pattern = ColorToBuffer::coltobuf(c, 0, 0) & BufferLayout::static_bufferdatamask();
+				for (int x = 0; x < pixelsPerWord(); x++)
+					units[BufferLayout::static_swx(x)] |= BufferLayout::static_shval(pattern, x, 0);
+				levelWords[c] = word;
+			}
+		}
+		return levelWords[color & ColorW8::static_colormask()];
+	}
+
+	virtual void clear(Color color = 0)
+	{
+		fillRect(0, 0, this->xres, this->yres, color);
+	}
+
+	virtual void xLine(int x0, int x1, int y, Color color)
+	{
+		if (x0 > x1)
+		{
+			int xb = x0;
+			x0 = x1;
+			x1 = xb;
+		}
+		fillRect(x0, y, x1 - x0, 1, color);
+	}
+
+	virtual void fillRect(int x, int y, int w, int h, Color color)
+	{
+		if (x < 0)
+		{
+			w += x;
+			x = 0;
+		}
+		if (y < 0)
+		{
+			h += y;
+			y = 0;
+		}
+		if (x + w > this->xres)
+			w = this->xres - x;
+		if (y + h > this->yres)
+			h = this->yres - y;
+		if (w <= 0 || h <= 0)
+			return;
+		//pixels that share a word with pixels outside of the area are set one by one
+		int wordStart = (x + pixelsPerWord() - 1) / pixelsPerWord();
+		int wordEnd = (x + w) / pixelsPerWord();
+		if (wordEnd <= wordStart)
+		{
+			for (int j = y; j < y + h; j++)
+				for (int i = x; i < x + w; i++)
+					this->dotFast(i, j, color);
+			return;
+		}
+		uint32_t word = levelWord(color);
+		for (int j = y; j < y + h; j++)
+		{
+			for (int i = x; i < wordStart * pixelsPerWord(); i++)
+				this->dotFast(i, j, color);
+			uint32_t *line = (uint32_t *)this->backBuffer[j];
+			for (int k = wordStart; k < wordEnd; k++)
+				line[k] = word;
+			for (int i = wordEnd * pixelsPerWord(); i < x + w; i++)
+				this->dotFast(i, j, color);
+		}
+	}
+
+	protected:
+	uint32_t levelWords[256];
+	int levelWordsMinValue;
+	int levelWordsFactor;
+};
@@ -10,11 +10,11 @@
 		http://bitluni.net
 */
 #pragma once
-#include "Graphics.h"
+#include "GraphicsW8PDM.h"
 #include "ColorToBuffer/CTBRangePDM8.h"
 #include "BufferLayouts/BLpx1sz8sw3sh0.h"
 
-class GraphicsW8RangedSwappedPDM: public Graphics<ColorW8, BLpx1sz8sw3sh0, CTBRangePDM8>
+class GraphicsW8RangedSwappedPDM: public GraphicsW8PDM<BLpx1sz8sw3sh0, CTBRangePDM8>
 {
 	public:
 
@@ -24,12 +24,4 @@ class GraphicsW8RangedSwappedPDM: public Graphics<ColorW8, BLpx1sz8sw3sh0, CTBRa
 		frontColor = 0xff;
 		defaultBufferValue = colorMinValue;
 	}
-
-	virtual void clear(Color color = 0)
-	{
-		BufferGraphicsUnit newColor = (BufferGraphicsUnit)static_shval(coltobuf(color & static_colormask(), 0, 0), 0, 0);
-		for (int y = 0; y < this->yres; y++)
-			for (int x = 0; x < this->xres; x++)
-				backBuffer[y][x] = newColor;
-	}
 };
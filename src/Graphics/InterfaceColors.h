@@ -11,7 +11,9 @@
 #include "Colors/InterfaceColors_ColorR8G8B8A8.h"
 #include "Colors/InterfaceColors_ColorR5G5B4A2.h"
 #include "Colors/InterfaceColors_ColorR2G2B2A2.h"
+#include "Colors/InterfaceColors_ColorR3G3B2.h"
 #include "Colors/InterfaceColors_ColorR1G1B1A1X4.h"
 #include "Colors/InterfaceColors_ColorW1X7.h"
 #include "Colors/InterfaceColors_ColorW8.h"
+#include "Colors/InterfaceColors_ColorW16.h"
 
@@ -40,6 +40,7 @@ class Mesh
 		  triangles(tris),
 		  triangleNormals(triNorms)
 	{
+		tTriNormals = 0;
 		tvertices = (short(*)[3])malloc(sizeof(short) * 3 * vertexCount);
 		if(!tvertices)
 			ERROR("Not enough memory for vertices");
@@ -53,7 +54,9 @@ class Mesh
 
 	~Mesh()
 	{
-		delete (tvertices);
+		//allocated with malloc
+		free(tvertices);
+		free(tTriNormals);
 	}
 
 	static Color basicTriangleShader(int trinangleNo, short *v0, short *v1, short *v2, const signed char *normal, Color color)
@@ -0,0 +1,123 @@
+/*
+	Author: bitluni 2019
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://youtube.com/bitlunislab
+		https://github.com/bitluni
+		http://bitluni.net
+*/
+#pragma once
+//the part of the Arduino API the library uses, for running it on a desktop host (Linux)
+//usage: add src/Host and src to the include path and compile src/Host/*.cpp and the library .cpp files with the program
+//nothing in here is compiled for ESP32 or ESP8266
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdio.h>
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define PI 3.1415926535897932384626433832795
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+class HostSerial
+{
+  public:
+	//the tools writing their results to stdout move the log to stderr
+	FILE *stream = stdout;
+	void begin(unsigned long baud) {}
+	void print(const char *s) { fputs(s, stream); }
+	void print(char c) { fputc(c, stream); }
+	void print(int n, int base = DEC) { print((long)n, base); }
+	void print(unsigned int n, int base = DEC) { print((unsigned long)n, base); }
+	void print(long n, int base = DEC)
+	{
+		if (base == DEC)
+			fprintf(stream, "%ld", n);
+		else
+			print((unsigned long)n, base);
+	}
+	void print(unsigned long n, int base = DEC)
+	{
+		if (base == HEX)
+			fprintf(stream, "%lX", n);
+		else if (base == OCT)
+			fprintf(stream, "%lo", n);
+		else if (base == BIN)
+		{
+			char s[65];
+			int i = 64;
+			s[i] = 0;
+			do
+			{
+				s[--i] = '0' + (n & 1);
+				n >>= 1;
+			} while (n);
+			fputs(&s[i], stream);
+		}
+		else
+			fprintf(stream, "%lu", n);
+	}
+	void print(long long n, int base = DEC) { print((long)n, base); }
+	void print(unsigned long long n, int base = DEC) { print((unsigned long)n, base); }
+	void print(double d, int digits = 2) { fprintf(stream, "%.*f", digits, d); }
+	template<class T>
+	void println(T v) { print(v); println(); }
+	template<class T>
+	void println(T v, int f) { print(v, f); println(); }
+	void println() { fputc('\n', stream); }
+};
+
+extern HostSerial Serial;
+
+//time is virtual, it passes in delay(), delayMicroseconds() and while waiting for a vsync
+//the emulated I2S devices send their samples (and raise their interrupts) meanwhile
+unsigned long long hostNanoseconds();
+void hostAdvance(unsigned long long nanoseconds);
+//called by hostAdvance, set by the I2S emulation when a device starts
+extern void (*hostDevicesAdvance)(unsigned long long nanoseconds);
+
+static inline unsigned long micros() { return (unsigned long)(hostNanoseconds() / 1000); }
+static inline unsigned long millis() { return (unsigned long)(hostNanoseconds() / 1000000); }
+//busy loops poll micros() around delay(0), so even that lets some time pass
+static inline void delay(unsigned long ms) { hostAdvance(ms ? ms * 1000000ull : 1000); }
+static inline void delayMicroseconds(unsigned int us) { hostAdvance(us * 1000ull); }
+
+#ifndef min
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#endif
+#ifndef max
+#define max(a, b) ((a) > (b) ? (a) : (b))
+#endif
+
+//allocator: plain malloc, the free sizes report a typical ESP32 heap (hostHeapBytes, hostDMAHeapBytes)
+#define MALLOC_CAP_EXEC (1 << 0)
+#define MALLOC_CAP_32BIT (1 << 1)
+#define MALLOC_CAP_8BIT (1 << 2)
+#define MALLOC_CAP_DMA (1 << 3)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_DEFAULT (1 << 12)
+
+extern size_t hostHeapBytes;
+extern size_t hostDMAHeapBytes;
+
+static inline void *heap_caps_malloc(size_t bytes, uint32_t caps) { return malloc(bytes); }
+static inline void heap_caps_free(void *p) { free(p); }
+static inline size_t heap_caps_get_free_size(uint32_t caps) { return (caps & MALLOC_CAP_DMA) ? hostDMAHeapBytes : hostHeapBytes; }
+static inline size_t heap_caps_get_largest_free_block(uint32_t caps) { return heap_caps_get_free_size(caps) / 2; }
+
+class HostESP
+{
+  public:
+	uint32_t getCpuFreqMHz() { return 240; }
+	uint32_t getFreeHeap() { return (uint32_t)hostHeapBytes; }
+};
+
+extern HostESP ESP;
@@ -0,0 +1,146 @@
+/*
+	Author: bitluni 2019
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://youtube.com/bitlunislab
+		https://github.com/bitluni
+		http://bitluni.net
+*/
+#pragma once
+#include <stdio.h>
+#include <stdlib.h>
+#include "../I2S/I2S.h"
+#include "../VGA/Mode.h"
+
+//collects the samples of one frame sent by an emulated I2S device (I2S_Host.cpp) and writes them as an image
+//a frame starts when the first descriptor of the ring comes up (vertical front porch of the VGA and composite engines)
+class FrameCapture
+{
+  public:
+	int width;  //samples per line
+	int height; //lines per frame
+	unsigned int *samples;
+	int sampleCount;
+	bool complete;
+
+	FrameCapture(int samplesPerLine, int lines)
+	{
+		width = samplesPerLine;
+		height = lines;
+		samples = (unsigned int *)calloc(width * height, sizeof(unsigned int));
+		sampleCount = 0;
+		complete = false;
+		armed = false;
+		capturing = false;
+	}
+
+	//the timings of a Mode or ModeComposite
+	template<class ModeType>
+	FrameCapture(const ModeType &mode)
+		: FrameCapture(mode.pixelsPerLine(), mode.linesPerField())
+	{
+	}
+
+	~FrameCapture()
+	{
+		free(samples);
+	}
+
+	void attach(I2S &i2s)
+	{
+		i2s.hostSinkArg = this;
+		i2s.hostSampleSink = sampleStatic;
+		i2s.hostFrameStart = frameStartStatic;
+	}
+
+	void detach(I2S &i2s)
+	{
+		i2s.hostSampleSink = 0;
+		i2s.hostFrameStart = 0;
+	}
+
+	//records the next complete frame, run the device (e.g. I2S::hostRunFrames(2)) until complete
+	void capture()
+	{
+		complete = false;
+		capturing = false;
+		armed = true;
+	}
+
+	unsigned int sample(int x, int y) const
+	{
+		return samples[y * width + x];
+	}
+
+	//the bits of mask packed together and scaled to 0-255
+	static int channel(unsigned int sample, unsigned int mask)
+	{
+		int v = 0;
+		int bits = 0;
+		for (unsigned int m = 1; m && m <= mask; m <<= 1)
+			if (mask & m)
+			{
+				if (sample & m)
+					v |= 1 << bits;
+				bits++;
+			}
+		return bits ? v * 255 / ((1 << bits) - 1) : 0;
+	}
+
+	//masks select the bits of each color in the samples (e.g. 0x1f, 0x3e0, 0x3c00 for VGA14Bit, 0xff00 for all three on the DAC)
+	//x0, y0, w, h: part of the frame to write, the whole frame by default
+	bool writePPM(const char *fileName, unsigned int redMask, unsigned int greenMask, unsigned int blueMask, int x0 = 0, int y0 = 0, int w = 0, int h = 0) const
+	{
+		if (!w) w = width - x0;
+		if (!h) h = height - y0;
+		FILE *f = fopen(fileName, "wb");
+		if (!f)
+			return false;
+		fprintf(f, "P6\n%d %d\n255\n", w, h);
+		for (int y = y0; y < y0 + h; y++)
+			for (int x = x0; x < x0 + w; x++)
+			{
+				unsigned int s = sample(x, y);
+				unsigned char rgb[3] = {(unsigned char)channel(s, redMask), (unsigned char)channel(s, greenMask), (unsigned char)channel(s, blueMask)};
+				fwrite(rgb, 1, 3, f);
+			}
+		fclose(f);
+		return true;
+	}
+
+	//the visible area of a VGA frame: the lines start with the horizontal blanking, the frame with the vertical one
+	bool writeVisiblePPM(const char *fileName, const Mode &mode, unsigned int redMask, unsigned int greenMask, unsigned int blueMask) const
+	{
+		return writePPM(fileName, redMask, greenMask, blueMask, mode.hFront + mode.hSync + mode.hBack, mode.vFront + mode.vSync + mode.vBack, mode.hRes, mode.vRes);
+	}
+
+  protected:
+	bool armed;
+	bool capturing;
+
+	static void sampleStatic(void *arg, unsigned int sample)
+	{
+		FrameCapture *c = (FrameCapture *)arg;
+		if (c->capturing && c->sampleCount < c->width * c->height)
+			c->samples[c->sampleCount++] = sample;
+	}
+
+	static void frameStartStatic(void *arg)
+	{
+		FrameCapture *c = (FrameCapture *)arg;
+		if (c->capturing)
+		{
+			c->capturing = false;
+			c->complete = true;
+		}
+		if (c->armed)
+		{
+			c->armed = false;
+			c->capturing = true;
+			c->sampleCount = 0;
+		}
+	}
+};
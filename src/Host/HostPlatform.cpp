@@ -0,0 +1,39 @@
+/*
+	Author: bitluni 2019
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://youtube.com/bitlunislab
+		https://github.com/bitluni
+		http://bitluni.net
+*/
+#if !defined(ESP32) && !defined(ESP8266)
+
+#include "Arduino.h"
+
+HostSerial Serial;
+HostESP ESP;
+
+size_t hostHeapBytes = 300 * 1024;
+size_t hostDMAHeapBytes = 180 * 1024;
+
+void (*hostDevicesAdvance)(unsigned long long nanoseconds) = 0;
+
+static unsigned long long hostTime = 0;
+
+unsigned long long hostNanoseconds()
+{
+	return hostTime;
+}
+
+void hostAdvance(unsigned long long nanoseconds)
+{
+	//the devices see the time pass first, so an interrupt raised meanwhile is served before the caller continues
+	if (hostDevicesAdvance)
+		hostDevicesAdvance(nanoseconds);
+	hostTime += nanoseconds;
+}
+
+#endif
@@ -0,0 +1,54 @@
+/*
+	Author: bitluni 2019
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://youtube.com/bitlunislab
+		https://github.com/bitluni
+		http://bitluni.net
+*/
+#pragma once
+#include "FreeRTOS.h"
+
+//binary semaphores, taking one lets virtual time pass until an interrupt gives it
+typedef void *SemaphoreHandle_t;
+
+static inline SemaphoreHandle_t xSemaphoreCreateBinary()
+{
+	int *s = (int *)malloc(sizeof(int));
+	if (s)
+		*s = 0;
+	return (SemaphoreHandle_t)s;
+}
+
+static inline void vSemaphoreDelete(SemaphoreHandle_t s) { free(s); }
+
+static inline BaseType_t xSemaphoreGive(SemaphoreHandle_t s)
+{
+	*(volatile int *)s = 1;
+	return pdTRUE;
+}
+
+static inline BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t s, BaseType_t *higherPriorityTaskWoken)
+{
+	*(volatile int *)s = 1;
+	return pdTRUE;
+}
+
+static inline BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t ticks)
+{
+	//portMAX_DELAY waits a virtual second at most, nothing else could give it
+	unsigned long long timeout = (ticks == portMAX_DELAY) ? 1000000000ull : ticks * portTICK_PERIOD_MS * 1000000ull;
+	unsigned long long waited = 0;
+	while (!*(volatile int *)s)
+	{
+		if (waited >= timeout)
+			return pdFALSE;
+		hostAdvance(10000);
+		waited += 10000;
+	}
+	*(volatile int *)s = 0;
+	return pdTRUE;
+}
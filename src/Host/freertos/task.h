@@ -0,0 +1,32 @@
+/*
+	Author: bitluni 2019
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://youtube.com/bitlunislab
+		https://github.com/bitluni
+		http://bitluni.net
+*/
+#pragma once
+#include "FreeRTOS.h"
+
+typedef void *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+//there are no threads: tasks are never created, the engines fall back to doing the work in the interrupt
+static inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t task, const char *name, uint32_t stack, void *arg, UBaseType_t priority, TaskHandle_t *handle, BaseType_t core)
+{
+	if (handle)
+		*handle = 0;
+	return pdFAIL;
+}
+
+static inline void vTaskDelete(TaskHandle_t task) {}
+
+static inline void vTaskDelay(TickType_t ticks) { delay(ticks * portTICK_PERIOD_MS); }
+
+static inline uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) { return 0; }
+
+static inline void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *higherPriorityTaskWoken) {}
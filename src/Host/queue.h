@@ -0,0 +1,21 @@
+/*
+	Author: bitluni 2019
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://youtube.com/bitlunislab
+		https://github.com/bitluni
+		http://bitluni.net
+*/
+#pragma once
+//the part of the BSD queue macros lldesc.h needs
+
+#define STAILQ_ENTRY(type) \
+	struct                 \
+	{                      \
+		struct type *stqe_next; \
+	}
+
+#define STAILQ_NEXT(elm, field) ((elm)->field.stqe_next)
@@ -0,0 +1,136 @@
+/*
+	Author: bitluni 2019
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://youtube.com/bitlunislab
+		https://github.com/bitluni
+		http://bitluni.net
+*/
+#pragma once
+#include <stdint.h>
+
+//audio PLL of the ESP32, the clock source of the parallel I2S output
+//xtal is 40M
+//chip revision 0
+//fxtal * (sdm2 + 4) / (2 * (odir + 2))
+//chip revision 1
+//fxtal * (sdm2 + (sdm1 / 256) + (sdm0 / 65536) + 4) / (2 * (odir + 2))
+//rtc_clk_apll_coeff_set(odir, sdm0, sdm1, sdm2);
+//                       0-31  0-255 0-255  0-63
+//sdm is a fixpoint number with 16bits fractional part: freq = 40000000 * (4 + sdm) / (2 * (odir + 2))
+struct APLLCoefficients
+{
+	long frequency;  //requested output frequency
+	long sdm;        //sdm2 << 16 | sdm1 << 8 | sdm0
+	int odir;
+	long achieved;   //output frequency of these coefficients (rounded to Hz)
+
+	int sdm0() const { return sdm & 255; }
+	int sdm1() const { return (sdm >> 8) & 255; }
+	int sdm2() const { return sdm >> 16; }
+};
+
+//integer only, no platform dependency (can be run on the host)
+class APLL
+{
+  public:
+	static const long xtal = 40000000;
+	//fxtal * (4 + sdm) is the VCO frequency, it has to stay above 350M
+	static const long sdmMin = 0x4c000;
+	//0xA7fffL doesn't work on all mcus
+	static const long sdmMax = 0xa1fff;
+
+	//exact output frequency of the coefficients in 1/256 Hz
+	static long long outputQ8(long sdm, int odir)
+	{
+		return ((long long)xtal * (sdm + 0x40000)) / ((odir + 2) * 512);
+	}
+
+	//nearest frequency every odir can produce, the closest one wins (the higher VCO on a tie)
+	//below the range of the VCO minimum (about 5.3M) the search goes on with a lower sdm,
+	//as the former search did, the chips run there (down to about 2.4M)
+	static APLLCoefficients solve(long frequency)
+	{
+		APLLCoefficients best = solve(frequency, sdmMin);
+		if (best.sdm == sdmMin && best.achieved > frequency)
+			best = solve(frequency, 0);
+		return best;
+	}
+
+	//nearest frequency with sdm from sdmLow to sdmMax
+	static APLLCoefficients solve(long frequency, long sdmLow)
+	{
+		APLLCoefficients best = {frequency, sdmMax, 0, 0};
+		long long bestError = -1;
+		long long targetQ8 = (long long)frequency << 8;
+		for (int odir = 0; odir < 32; odir++)
+		{
+			//sdm = frequency * 2 * (odir + 2) / fxtal - 4, rounded
+			long long d = (long long)frequency * (odir + 2) * 0x10000;
+			long sdm = (long)((d + xtal / 4) / (xtal / 2)) - 0x40000;
+			if (sdm < sdmLow) sdm = sdmLow;
+			if (sdm > sdmMax) sdm = sdmMax;
+			long long error = outputQ8(sdm, odir) - targetQ8;
+			if (error < 0) error = -error;
+			if (bestError < 0 || error < bestError || (error == bestError && sdm > best.sdm))
+			{
+				bestError = error;
+				best.sdm = sdm;
+				best.odir = odir;
+			}
+		}
+		best.achieved = (long)((outputQ8(best.sdm, best.odir) + 128) >> 8);
+		return best;
+	}
+
+	//the table of the preset modes first, the solver for anything else
+	static APLLCoefficients coefficients(long frequency)
+	{
+		int count;
+		const APLLCoefficients *table = presets(count);
+		for (int i = 0; i < count; i++)
+			if (table[i].frequency == frequency)
+				return table[i];
+		return solve(frequency);
+	}
+
+	//output frequencies of the VGAMode and CompMode presets (pixel clock * 2 and * 4 for 8 and 16 bit output)
+	//generated with solve(), the ones outside of the APLL range are left to it
+	//(4M is below the VCO minimum, it runs with a lower sdm)
+	static const APLLCoefficients *presets(int &count)
+	{
+		static const APLLCoefficients table[] = {
+			{4000000, 0x20000, 28, 4000000},
+			{8000000, 0x80000, 28, 8000000},
+			{14487318, 0x9c351, 17, 14487321},
+			{16000000, 0x80000, 13, 16000000},
+			{18000000, 0x98000, 13, 18000000},
+			{20000000, 0xa0000, 12, 20000000},
+			{23979010, 0x7fd50, 8, 23979004},
+			{25120000, 0x74dd3, 7, 25120002},
+			{25175000, 0x75429, 7, 25175001},
+			{26666666, 0x80000, 7, 26666667},
+			{28322000, 0x8beb2, 7, 28322008},
+			{28974636, 0x909e1, 7, 28974643},
+			{32000000, 0x8cccd, 6, 32000008},
+			{36000000, 0x50000, 3, 36000000},
+			{39335936, 0x9c480, 5, 39335938},
+			{40000000, 0xa0000, 5, 40000000},
+			{47958020, 0x7fd50, 3, 47958008},
+			{50240000, 0x88f5c, 3, 50239990},
+			{50350000, 0x89666, 3, 50349976},
+			{53333332, 0x95555, 3, 53333313},
+			{56644000, 0x7542c, 2, 56643982},
+			{72000000, 0x6cccd, 1, 72000020},
+			{78671872, 0x7cd00, 1, 78671875},
+			{100700000, 0x611ec, 0, 100700073},
+			{113288000, 0x7542c, 0, 113287964},
+			{130000000, 0x90000, 0, 130000000}
+		};
+		count = sizeof(table) / sizeof(APLLCoefficients);
+		return table;
+	}
+};
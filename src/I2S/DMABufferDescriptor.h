@@ -10,7 +10,9 @@
 		http://bitluni.net
 */
 #pragma once
+#include <string.h>
 #include "../Tools/Log.h"
+#include "../Tools/MemoryArena.h"
 #ifdef ESP32
   #include "rom/lldesc.h"
 #else
@@ -32,7 +34,7 @@ class DMABufferDescriptor : protected lldesc_t
 			DEBUG_PRINTLN("Failed to alloc dma buffer");
 		if (clear)
 			for (int i = 0; i < bytes / 4; i++)
-				((unsigned long *)b)[i] = clearValue;
+				((uint32_t *)b)[i] = clearValue;
 		return b;
 	}
 
@@ -67,6 +69,13 @@ class DMABufferDescriptor : protected lldesc_t
 		return (int)size;
 	}
 
+	//copies the content of another line, lines sharing the buffer already have it
+	__attribute__((always_inline)) inline void copyBufferFrom(const DMABufferDescriptor &other)
+	{
+		if (other.buffer() != buffer())
+			memcpy(buffer(), other.buffer(), getSize());
+	}
+
 	void init()
 	{
 		length = 0;
@@ -94,6 +103,17 @@ class DMABufferDescriptor : protected lldesc_t
 		return b;
 	}
 
+	//carved from the arena, freed with it
+	static DMABufferDescriptor *allocateDescriptors(int count, MemoryArena &arena)
+	{
+		DMABufferDescriptor *b = (DMABufferDescriptor *)arena.allocate(sizeof(DMABufferDescriptor) * count, false);
+		if (!b)
+			ERROR("Not enough DMA memory for descriptors");
+		for (int i = 0; i < count; i++)
+			b[i].init();
+		return b;
+	}
+
 	static DMABufferDescriptor *allocateDescriptor(int bytes, bool allocBuffer = true, bool clear = true, unsigned long clearValue = 0)
 	{
 		bytes = (bytes + 3) & 0xfffffffc;
@@ -115,6 +135,27 @@ class DMABufferDescriptor : protected lldesc_t
 		qe.stqe_next = &next;
 	}
 
+	//only descriptors flagged with eof raise the out_eof interrupt when consumed
+	void setEOF(bool endOfFrame)
+	{
+		eof = endOfFrame ? 1 : 0;
+	}
+
+	DMABufferDescriptor *getNext() const
+	{
+		return (DMABufferDescriptor *)qe.stqe_next;
+	}
+
+	bool getEOF() const
+	{
+		return eof;
+	}
+
+	int getLength() const
+	{
+		return (int)length;
+	}
+
 	int sampleCount() const
 	{
 		return length / 4;
@@ -12,6 +12,50 @@
 #pragma once
 
 #include "DMABufferDescriptor.h"
+#include "APLL.h"
+
+//uncomment (or pass -DI2S_INTERRUPT_STATS as a build flag) to measure the interrupt routines
+//costs nothing when left undefined
+//#define I2S_INTERRUPT_STATS
+
+#ifdef I2S_INTERRUPT_STATS
+//counters filled by the interrupt, read them from the main loop with I2S::getInterruptStats()
+struct I2SInterruptStats
+{
+	static const int histogramBuckets = 16;
+	unsigned long interrupts;      //out_eof interrupts served
+	unsigned long frames;          //complete passes over the descriptor ring
+	unsigned long linesRendered;   //lines handed to the renderer
+	unsigned long linesLate;       //lines probably finished after the DMA started sending them (estimated)
+	unsigned long linesSkipped;    //lines whose interrupt never came (gap between EOF descriptors)
+	unsigned long lineCyclesMin;   //render cycles per line
+	unsigned long lineCyclesMax;
+	unsigned long long lineCyclesTotal; //average is lineCyclesTotal / linesRendered
+	//bucket i counts lines rendered in [2^(i+6), 2^(i+7)) cycles, the first and the last one also take what falls outside
+	unsigned long lineCyclesHistogram[histogramBuckets];
+	int frameLoadPercent;          //share of the last frame spent inside the interrupt
+	int frameLoadPercentMax;
+};
+
+#if defined(ESP32) || defined(ESP8266)
+//cpu cycle counter of the xtensa cores (ESP32 and ESP8266)
+static inline __attribute__((always_inline)) unsigned long I2SCycleCount()
+{
+	unsigned long cycles;
+	__asm__ __volatile__("rsr %0, ccount" : "=a"(cycles));
+	return cycles;
+}
+#else
+#include <time.h>
+//host: real time spent, counted in cycles of a 240MHz core
+static inline unsigned long I2SCycleCount()
+{
+	timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (unsigned long)(((unsigned long long)t.tv_sec * 1000000000ull + t.tv_nsec) * 240 / 1000);
+}
+#endif
+#endif
 
 class I2S
 {
@@ -22,6 +66,8 @@ class I2S
 	int dmaBufferDescriptorActive;
 	DMABufferDescriptor *dmaBufferDescriptors;
 	volatile bool stopSignal;
+	//coefficients of the last APLL setup, achieved is the frequency really generated
+	APLLCoefficients apllClock;
 
 	/// hardware index [0, 1]
 	I2S(const int i2sIndex = 0);
@@ -49,6 +95,27 @@ class I2S
 
 	void (*interruptStaticChild)(void *arg) = 0;
 
+#if !defined(ESP32) && !defined(ESP8266)
+	//host emulation (I2S_Host.cpp): the descriptor ring is walked while virtual time passes (see Host/Arduino.h)
+	//every sample sent is handed to hostSampleSink, hostFrameStart is called whenever the first descriptor comes up again
+	void (*hostSampleSink)(void *arg, unsigned int sample) = 0;
+	void (*hostFrameStart)(void *arg) = 0;
+	void *hostSinkArg = 0;
+	//sends the samples of the given time, serving the interrupts on the way
+	void hostAdvance(unsigned long long nanoseconds);
+	//sends until the first descriptor comes up again count times
+	void hostRunFrames(int count);
+#endif
+
+#ifdef I2S_INTERRUPT_STATS
+	//descriptorsPerInterrupt: descriptors consumed between two EOF flags, ringDescriptors: descriptors of one frame
+	//slackLines: line periods left between an interrupt and the display of the first line it renders
+	void setInterruptStatsTiming(int descriptorsPerInterrupt, int descriptorsPerLine, int ringDescriptors, long lineNanoseconds, int slackLines);
+	void getInterruptStats(I2SInterruptStats &stats) const;
+	void resetInterruptStats();
+	void printInterruptStats() const;
+#endif
+
   protected:
 	virtual bool useInterrupt();
 	void setAPLLClock(long sampleRate, int bitCount);
@@ -56,4 +123,28 @@ class I2S
 	
   private:
 	static void IRAM_ATTR interruptStatic(void *arg);
+#if !defined(ESP32) && !defined(ESP8266)
+	bool hostRunning;
+	bool hostInterruptEnabled;
+	long hostSampleRate;
+	int hostBytesPerSample;
+	DMABufferDescriptor *hostDescriptor;
+	int hostSample;
+	unsigned long long hostTimeRemainder;
+	unsigned long hostFrames;
+	int hostSendSamples(unsigned long long samples);
+	static void hostAdvanceAll(unsigned long long nanoseconds);
+#endif
+#ifdef I2S_INTERRUPT_STATS
+	static void IRAM_ATTR interruptStatsRecord(I2S *i2s, unsigned long entryCycles, unsigned long exitCycles, int previousDescriptor);
+	I2SInterruptStats interruptStats;
+	unsigned long statsLastEntryCycles;
+	unsigned long statsFrameStartCycles;
+	unsigned long statsFrameInterruptCycles;
+	int statsDescriptorsPerInterrupt;
+	int statsDescriptorsPerLine;
+	int statsRingDescriptors;
+	long statsLineCycles;
+	int statsSlackLines;
+#endif
 };
@@ -0,0 +1,165 @@
+/*
+	Author: bitluni 2019
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://youtube.com/bitlunislab
+		https://github.com/bitluni
+		http://bitluni.net
+*/
+
+#include "I2S.h"
+
+#ifdef I2S_INTERRUPT_STATS
+
+#include "../Tools/Log.h"
+
+void I2S::setInterruptStatsTiming(int descriptorsPerInterrupt, int descriptorsPerLine, int ringDescriptors, long lineNanoseconds, int slackLines)
+{
+	statsDescriptorsPerInterrupt = descriptorsPerInterrupt < 1 ? 1 : descriptorsPerInterrupt;
+	statsDescriptorsPerLine = descriptorsPerLine < 1 ? 1 : descriptorsPerLine;
+	statsRingDescriptors = ringDescriptors;
+	statsLineCycles = (long)((long long)lineNanoseconds * ESP.getCpuFreqMHz() / 1000);
+	statsSlackLines = slackLines;
+	resetInterruptStats();
+}
+
+void I2S::resetInterruptStats()
+{
+	//the interrupt may update a counter while this runs, at worst one sample is lost
+	interruptStats.interrupts = 0;
+	interruptStats.frames = 0;
+	interruptStats.linesRendered = 0;
+	interruptStats.linesLate = 0;
+	interruptStats.linesSkipped = 0;
+	interruptStats.lineCyclesMin = 0xffffffff;
+	interruptStats.lineCyclesMax = 0;
+	interruptStats.lineCyclesTotal = 0;
+	for (int i = 0; i < I2SInterruptStats::histogramBuckets; i++)
+		interruptStats.lineCyclesHistogram[i] = 0;
+	interruptStats.frameLoadPercent = 0;
+	interruptStats.frameLoadPercentMax = 0;
+	statsLastEntryCycles = 0;
+	statsFrameStartCycles = 0;
+	statsFrameInterruptCycles = 0;
+}
+
+void I2S::getInterruptStats(I2SInterruptStats &stats) const
+{
+	//copy again if an interrupt came in between
+	unsigned long interrupts;
+	do
+	{
+		interrupts = *(volatile const unsigned long *)&interruptStats.interrupts;
+		__asm__ __volatile__("" ::: "memory");
+		stats = interruptStats;
+		__asm__ __volatile__("" ::: "memory");
+	} while (interrupts != *(volatile const unsigned long *)&interruptStats.interrupts);
+}
+
+void I2S::printInterruptStats() const
+{
+	I2SInterruptStats stats;
+	getInterruptStats(stats);
+	DEBUG_PRINT("Interrupts: ");
+	DEBUG_PRINT(stats.interrupts);
+	DEBUG_PRINT(", frames: ");
+	DEBUG_PRINTLN(stats.frames);
+	DEBUG_PRINT("Lines rendered: ");
+	DEBUG_PRINT(stats.linesRendered);
+	DEBUG_PRINT(", late: ");
+	DEBUG_PRINT(stats.linesLate);
+	DEBUG_PRINT(", skipped: ");
+	DEBUG_PRINTLN(stats.linesSkipped);
+	if (stats.linesRendered)
+	{
+		DEBUG_PRINT("Cycles per line min/avg/max: ");
+		DEBUG_PRINT(stats.lineCyclesMin);
+		DEBUG_PRINT("/");
+		DEBUG_PRINT((unsigned long)(stats.lineCyclesTotal / stats.linesRendered));
+		DEBUG_PRINT("/");
+		DEBUG_PRINT(stats.lineCyclesMax);
+		DEBUG_PRINT(" (budget ");
+		DEBUG_PRINT(statsLineCycles);
+		DEBUG_PRINTLN(")");
+	}
+	DEBUG_PRINT("Interrupt load % last/max: ");
+	DEBUG_PRINT(stats.frameLoadPercent);
+	DEBUG_PRINT("/");
+	DEBUG_PRINTLN(stats.frameLoadPercentMax);
+	for (int i = 0; i < I2SInterruptStats::histogramBuckets; i++)
+	{
+		if (!stats.lineCyclesHistogram[i]) continue;
+		DEBUG_PRINT("  < ");
+		DEBUG_PRINT(1ul << (i + 7));
+		DEBUG_PRINT(" cycles: ");
+		DEBUG_PRINTLN(stats.lineCyclesHistogram[i]);
+	}
+}
+
+void IRAM_ATTR I2S::interruptStatsRecord(I2S *i2s, unsigned long entryCycles, unsigned long exitCycles, int previousDescriptor)
+{
+	I2SInterruptStats &stats = i2s->interruptStats;
+	unsigned long interruptCycles = exitCycles - entryCycles;
+	int lines = i2s->statsDescriptorsPerInterrupt / i2s->statsDescriptorsPerLine;
+	if (lines < 1) lines = 1;
+	unsigned long lineCycles = interruptCycles / lines;
+
+	//how late the interrupt came compared to the lines consumed since the previous one
+	unsigned long entryDelay = 0;
+	bool frameEnded = false;
+	if (stats.interrupts > 0 && i2s->statsRingDescriptors > 0)
+	{
+		int consumed = i2s->dmaBufferDescriptorActive - previousDescriptor;
+		if (consumed <= 0)
+		{
+			consumed += i2s->statsRingDescriptors;
+			frameEnded = true;
+		}
+		if (consumed > i2s->statsDescriptorsPerInterrupt)
+			stats.linesSkipped += (consumed - i2s->statsDescriptorsPerInterrupt) / i2s->statsDescriptorsPerLine;
+		unsigned long expected = (unsigned long)(consumed / i2s->statsDescriptorsPerLine) * i2s->statsLineCycles;
+		unsigned long elapsed = entryCycles - i2s->statsLastEntryCycles;
+		if (elapsed > expected)
+			entryDelay = elapsed - expected;
+	}
+
+	//the k-th line of the batch is displayed (slackLines + k) line periods after the interrupt was raised
+	if (i2s->statsLineCycles > 0)
+		for (int k = 0; k < lines; k++)
+			if (entryDelay + (k + 1) * lineCycles > (unsigned long)(i2s->statsSlackLines + k) * i2s->statsLineCycles)
+				stats.linesLate++;
+
+	stats.interrupts++;
+	stats.linesRendered += lines;
+	stats.lineCyclesTotal += interruptCycles;
+	if (lineCycles < stats.lineCyclesMin) stats.lineCyclesMin = lineCycles;
+	if (lineCycles > stats.lineCyclesMax) stats.lineCyclesMax = lineCycles;
+	int bucket = (31 - __builtin_clz(lineCycles | 1)) - 6;
+	if (bucket < 0) bucket = 0;
+	if (bucket >= I2SInterruptStats::histogramBuckets) bucket = I2SInterruptStats::histogramBuckets - 1;
+	stats.lineCyclesHistogram[bucket] += lines;
+
+	if (frameEnded)
+	{
+		if (i2s->statsFrameStartCycles)
+		{
+			unsigned long frameCycles = entryCycles - i2s->statsFrameStartCycles;
+			if (frameCycles)
+			{
+				stats.frameLoadPercent = (int)((unsigned long long)i2s->statsFrameInterruptCycles * 100 / frameCycles);
+				if (stats.frameLoadPercent > stats.frameLoadPercentMax)
+					stats.frameLoadPercentMax = stats.frameLoadPercent;
+			}
+			stats.frames++;
+		}
+		i2s->statsFrameStartCycles = entryCycles;
+		i2s->statsFrameInterruptCycles = 0;
+	}
+	i2s->statsFrameInterruptCycles += interruptCycles;
+	i2s->statsLastEntryCycles = entryCycles;
+}
+
+#endif
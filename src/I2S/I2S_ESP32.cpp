@@ -47,11 +47,24 @@ I2S::I2S(const int i2sIndex)
 	dmaBufferDescriptorActive = 0;
 	dmaBufferDescriptors = 0;
 	stopSignal = false;
+	apllClock = APLLCoefficients();
+#ifdef I2S_INTERRUPT_STATS
+	statsDescriptorsPerInterrupt = 1;
+	statsDescriptorsPerLine = 1;
+	statsRingDescriptors = 0;
+	statsLineCycles = 0;
+	statsSlackLines = 0;
+	resetInterruptStats();
+#endif
 }
 
 void IRAM_ATTR I2S::interruptStatic(void *arg)
 {
 	volatile i2s_dev_t &i2s = *i2sDevices[((I2S *)arg)->i2sIndex];
+#ifdef I2S_INTERRUPT_STATS
+	unsigned long entryCycles = I2SCycleCount();
+	int previousDescriptor = ((I2S *)arg)->dmaBufferDescriptorActive;
+#endif
 
 	//CLEAR THE INTERRUPT FLAG
 	//i2s object not safely accesed in DRAM or IRAM
@@ -74,6 +87,9 @@ void IRAM_ATTR I2S::interruptStatic(void *arg)
 	//((I2S *)arg)->interrupt();
 	if(((I2S *)arg)->interruptStaticChild)
 		((I2S *)arg)->interruptStaticChild(arg);
+#ifdef I2S_INTERRUPT_STATS
+	interruptStatsRecord((I2S *)arg, entryCycles, I2SCycleCount(), previousDescriptor);
+#endif
 }
 
 void I2S::reset()
@@ -258,7 +274,8 @@ bool I2S::initParallelInputMode(const int *pinMap, long sampleRate, const int bi
 
 	//allocate disabled i2s interrupt
 	const int interruptSource[] = {ETS_I2S0_INTR_SOURCE, ETS_I2S1_INTR_SOURCE};
-	if(useInterrupt())
+	//the interrupt stays allocated across inits (only the first one allocates it)
+	if(useInterrupt() && !interruptHandle)
 		esp_intr_alloc(interruptSource[i2sIndex], ESP_INTR_FLAG_INTRDISABLED | ESP_INTR_FLAG_LEVEL3 | ESP_INTR_FLAG_IRAM, &interruptStatic, this, reinterpret_cast<intr_handle_t*>(&interruptHandle));
 	return true;
 }
@@ -347,38 +364,7 @@ bool I2S::initParallelOutputMode(const int *pinMap, const int *pinMapBit, const
 	if(sampleRate == 0)
 		getClockSetting(&sampleRate, &clockN, &clockA, &clockB, &clockDiv);
 	if(sampleRate > 0)
-	{
-		//xtal is 40M
-		//chip revision 0
-		//fxtal * (sdm2 + 4) / (2 * (odir + 2))
-		//chip revision 1
-		//fxtal * (sdm2 + (sdm1 / 256) + (sdm0 / 65536) + 4) / (2 * (odir + 2))
-		//fxtal * (sdm2 + (sdm1 / 256) + (sdm0 / 65536) + 4) needs to be btween 350M and 500M
-		//rtc_clk_apll_enable(enable, sdm0, sdm1, sdm2, odir);
-		//                           0-255 0-255  0-63  0-31
-		//sdm seems to be simply a fixpoint number with 16bits fractional part
-		//freq = 40000000L * (4 + sdm) / (2 * (odir + 2))
-		//sdm = freq / (20000000L / (odir + 2)) - 4;
-		long freq = sampleRate * 2 * (bitCount / 8);
-		int sdm, sdmn;
-		int odir = -1;
-		do
-		{	
-			odir++;
-			sdm = long((double(freq) / (20000000. / (odir + 2))) * 0x10000) - 0x40000;
-			sdmn = long((double(freq) / (20000000. / (odir + 2 + 1))) * 0x10000) - 0x40000;
-		}while(sdm < 0x8c0ecL && odir < 31 && sdmn < 0xA1fff); //0xA7fffL doesn't work on all mcus 
-		//DEBUG_PRINTLN(sdm & 255);
-		//DEBUG_PRINTLN((sdm >> 8) & 255);
-		//DEBUG_PRINTLN(sdm >> 16);
-		//DEBUG_PRINTLN(odir);
-		//sdm = 0xA1fff;
-		//odir = 0;
-		if(sdm > 0xA1fff) sdm = 0xA1fff;
-		//rtc_clk_apll_enable(true, sdm & 255, (sdm >> 8) & 255, sdm >> 16, odir);
-		rtc_clk_apll_enable(true);
-		rtc_clk_apll_coeff_set(odir, sdm & 255, (sdm >> 8) & 255, sdm >> 16);
-	}
+		setAPLLClock(sampleRate, bitCount);
 
 	i2s.clkm_conf.val = 0;
 	i2s.clkm_conf.clka_en = sampleRate > 0 ? 1 : 0;
@@ -413,7 +399,8 @@ bool I2S::initParallelOutputMode(const int *pinMap, const int *pinMapBit, const
 
 	//allocate disabled i2s interrupt
 	const int interruptSource[] = {ETS_I2S0_INTR_SOURCE, ETS_I2S1_INTR_SOURCE};
-	if(useInterrupt())
+	//the interrupt stays allocated across inits (only the first one allocates it)
+	if(useInterrupt() && !interruptHandle)
 		esp_intr_alloc(interruptSource[i2sIndex], ESP_INTR_FLAG_INTRDISABLED | ESP_INTR_FLAG_LEVEL3 | ESP_INTR_FLAG_IRAM, &interruptStatic, this, reinterpret_cast<intr_handle_t*>(&interruptHandle));
 	return true;
 }
@@ -430,36 +417,10 @@ void I2S::enableDAC(int selectedDACs)
 
 void I2S::setAPLLClock(long sampleRate, int bitCount)
 {
-	//xtal is 40M
-	//chip revision 0
-	//fxtal * (sdm2 + 4) / (2 * (odir + 2))
-	//chip revision 1
-	//fxtal * (sdm2 + (sdm1 / 256) + (sdm0 / 65536) + 4) / (2 * (odir + 2))
-	//fxtal * (sdm2 + (sdm1 / 256) + (sdm0 / 65536) + 4) needs to be btween 350M and 500M
-	//rtc_clk_apll_enable(enable, sdm0, sdm1, sdm2, odir);
-	//                           0-255 0-255  0-63  0-31
-	//sdm seems to be simply a fixpoint number with 16bits fractional part
-	//freq = 40000000L * (4 + sdm) / (2 * (odir + 2))
-	//sdm = freq / (20000000L / (odir + 2)) - 4;
-	long freq = sampleRate * 2 * (bitCount / 8);
-	int sdm, sdmn;
-	int odir = -1;
-	do
-	{	
-		odir++;
-		sdm = long((double(freq) / (20000000. / (odir + 2))) * 0x10000) - 0x40000;
-		sdmn = long((double(freq) / (20000000. / (odir + 2 + 1))) * 0x10000) - 0x40000;
-	}while(sdm < 0x8c0ecL && odir < 31 && sdmn < 0xA1fff); //0xA7fffL doesn't work on all mcus 
-	//DEBUG_PRINTLN(sdm & 255);
-	//DEBUG_PRINTLN((sdm >> 8) & 255);
-	//DEBUG_PRINTLN(sdm >> 16);
-	//DEBUG_PRINTLN(odir);
-	//sdm = 0xA1fff;
-	//odir = 0;
-	if(sdm > 0xA1fff) sdm = 0xA1fff;
-	//rtc_clk_apll_enable(true, sdm & 255, (sdm >> 8) & 255, sdm >> 16, odir);
+	//the presets come from a table, other frequencies are solved for the smallest error (see APLL.h)
+	apllClock = APLL::coefficients(sampleRate * 2 * (bitCount / 8));
 	rtc_clk_apll_enable(true);
-	rtc_clk_apll_coeff_set(odir, sdm & 255, (sdm >> 8) & 255, sdm >> 16);
+	rtc_clk_apll_coeff_set(apllClock.odir, apllClock.sdm0(), apllClock.sdm1(), apllClock.sdm2());
 }
 
 void I2S::setClock(long sampleRate, int bitCount, bool useAPLL)
@@ -559,7 +520,8 @@ bool I2S::initSerialOutputMode(int dataPin, const int bitCount, int wordSelect,
 
 	//allocate disabled i2s interrupt
 	const int interruptSource[] = {ETS_I2S0_INTR_SOURCE, ETS_I2S1_INTR_SOURCE};
-	if(useInterrupt())
+	//the interrupt stays allocated across inits (only the first one allocates it)
+	if(useInterrupt() && !interruptHandle)
 		esp_intr_alloc(interruptSource[i2sIndex], ESP_INTR_FLAG_INTRDISABLED | ESP_INTR_FLAG_LEVEL3 | ESP_INTR_FLAG_IRAM, &interruptStatic, this, reinterpret_cast<intr_handle_t*>(&interruptHandle));
 	return true;
 }
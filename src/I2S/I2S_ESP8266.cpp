@@ -36,6 +36,15 @@ I2S::I2S(const int i2sIndex)
 	dmaBufferDescriptorActive = 0;
 	dmaBufferDescriptors = 0;
 	stopSignal = false;
+	apllClock = APLLCoefficients();
+#ifdef I2S_INTERRUPT_STATS
+	statsDescriptorsPerInterrupt = 1;
+	statsDescriptorsPerLine = 1;
+	statsRingDescriptors = 0;
+	statsLineCycles = 0;
+	statsSlackLines = 0;
+	resetInterruptStats();
+#endif
 }
 
 void IRAM_ATTR I2S::interruptStatic(void *arg)
@@ -43,6 +52,10 @@ void IRAM_ATTR I2S::interruptStatic(void *arg)
 	lldesc_t *finishedDesc;
 	uint32 slc_intr_status;
 	uint8_t x;
+#ifdef I2S_INTERRUPT_STATS
+	unsigned long entryCycles = I2SCycleCount();
+	int previousDescriptor = ((I2S *)arg)->dmaBufferDescriptorActive;
+#endif
 
 	//Grab int status
 	slc_intr_status = READ_PERI_REG(SLC_INT_STATUS);
@@ -64,6 +77,9 @@ void IRAM_ATTR I2S::interruptStatic(void *arg)
 
 	if(((I2S *)arg)->interruptStaticChild)
 		((I2S *)arg)->interruptStaticChild(arg);
+#ifdef I2S_INTERRUPT_STATS
+	interruptStatsRecord((I2S *)arg, entryCycles, I2SCycleCount(), previousDescriptor);
+#endif
 }
 
 void I2S::reset()
@@ -0,0 +1,284 @@
+/*
+	Author: bitluni 2019
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://youtube.com/bitlunislab
+		https://github.com/bitluni
+		http://bitluni.net
+*/
+
+#if !defined(ESP32) && !defined(ESP8266)
+
+//emulation of the I2S output for running the engines on a desktop host
+//the DMA walks the descriptor ring while virtual time passes (see Host/Arduino.h) and raises the EOF interrupts
+#include "I2S.h"
+#include "../Tools/Log.h"
+
+//the running devices, one per hardware index
+static I2S *hostDevices[2] = {0, 0};
+
+I2S::I2S(const int i2sIndex)
+{
+	this->i2sIndex = i2sIndex;
+	interruptHandle = 0;
+	dmaBufferDescriptorCount = 0;
+	dmaBufferDescriptorActive = 0;
+	dmaBufferDescriptors = 0;
+	stopSignal = false;
+	apllClock = APLLCoefficients();
+	hostRunning = false;
+	hostInterruptEnabled = false;
+	hostSampleRate = 0;
+	hostBytesPerSample = 1;
+	hostDescriptor = 0;
+	hostSample = 0;
+	hostTimeRemainder = 0;
+	hostFrames = 0;
+#ifdef I2S_INTERRUPT_STATS
+	statsDescriptorsPerInterrupt = 1;
+	statsDescriptorsPerLine = 1;
+	statsRingDescriptors = 0;
+	statsLineCycles = 0;
+	statsSlackLines = 0;
+	resetInterruptStats();
+#endif
+}
+
+void I2S::interruptStatic(void *arg)
+{
+#ifdef I2S_INTERRUPT_STATS
+	unsigned long entryCycles = I2SCycleCount();
+	int previousDescriptor = ((I2S *)arg)->dmaBufferDescriptorActive;
+#endif
+	//dmaBufferDescriptorActive was set to the descriptor that just finished
+	if(((I2S *)arg)->interruptStaticChild)
+		((I2S *)arg)->interruptStaticChild(arg);
+#ifdef I2S_INTERRUPT_STATS
+	interruptStatsRecord((I2S *)arg, entryCycles, I2SCycleCount(), previousDescriptor);
+#endif
+}
+
+void I2S::hostAdvanceAll(unsigned long long nanoseconds)
+{
+	for (int i = 0; i < 2; i++)
+		if (hostDevices[i])
+			hostDevices[i]->hostAdvance(nanoseconds);
+}
+
+void I2S::hostAdvance(unsigned long long nanoseconds)
+{
+	//a second at a time keeps the product in 64 bits
+	while (hostRunning && nanoseconds)
+	{
+		unsigned long long ns = nanoseconds > 1000000000ull ? 1000000000ull : nanoseconds;
+		nanoseconds -= ns;
+		unsigned long long t = ns * hostSampleRate + hostTimeRemainder;
+		hostTimeRemainder = t % 1000000000ull;
+		hostSendSamples(t / 1000000000ull);
+	}
+}
+
+void I2S::hostRunFrames(int count)
+{
+	unsigned long frames = hostFrames + count;
+	//the global clock advances, so the other device keeps running as well
+	while (hostRunning && (long)(frames - hostFrames) > 0)
+		::hostAdvance(100000);
+}
+
+int I2S::hostSendSamples(unsigned long long samples)
+{
+	int sent = 0;
+	while (samples > 0 && hostRunning && hostDescriptor)
+	{
+		if (hostSample == 0 && hostDescriptor == firstDescriptorAddress())
+		{
+			hostFrames++;
+			if (hostFrameStart)
+				hostFrameStart(hostSinkArg);
+		}
+		int count = hostDescriptor->getLength() / hostBytesPerSample;
+		int n = count - hostSample;
+		if ((unsigned long long)n > samples)
+			n = (int)samples;
+		if (hostSampleSink)
+		{
+			//the samples leave in the order of the hardware: bytes 2, 3, 0, 1 of a word in 8 bit mode, words 1, 0 in 16 bit mode
+			const uint8_t *b = (const uint8_t *)hostDescriptor->buffer();
+			for (int i = hostSample; i < hostSample + n; i++)
+			{
+				unsigned int s;
+				if (hostBytesPerSample == 1)
+					s = b[i ^ 2];
+				else if (hostBytesPerSample == 2)
+					s = ((const uint16_t *)b)[i ^ 1];
+				else
+					s = ((const uint32_t *)b)[i];
+				hostSampleSink(hostSinkArg, s);
+			}
+		}
+		hostSample += n;
+		samples -= n;
+		sent += n;
+		if (hostSample < count)
+			break;
+		DMABufferDescriptor *finished = hostDescriptor;
+		hostDescriptor = finished->getNext();
+		hostSample = 0;
+		if (finished->getEOF() && hostInterruptEnabled)
+		{
+			dmaBufferDescriptorActive = finished - dmaBufferDescriptors;
+			interruptStatic(this);
+		}
+	}
+	return sent;
+}
+
+void I2S::reset()
+{
+	hostDescriptor = 0;
+	hostSample = 0;
+	hostTimeRemainder = 0;
+}
+
+void I2S::i2sStop()
+{
+	hostRunning = false;
+	hostInterruptEnabled = false;
+	if (hostDevices[i2sIndex] == this)
+		hostDevices[i2sIndex] = 0;
+	reset();
+}
+
+void I2S::startTX()
+{
+	DEBUG_PRINTLN("I2S TX");
+	reset();
+	dmaBufferDescriptorActive = 0;
+	hostDescriptor = firstDescriptorAddress();
+	hostInterruptEnabled = useInterrupt();
+	hostRunning = true;
+	hostDevices[i2sIndex] = this;
+	hostDevicesAdvance = &hostAdvanceAll;
+}
+
+void I2S::startRX()
+{
+	DEBUG_PRINTLN("I2S RX is not emulated");
+}
+
+void I2S::resetDMA()
+{
+}
+
+void I2S::resetFIFO()
+{
+}
+
+DMABufferDescriptor *I2S::firstDescriptorAddress() const
+{
+	return &dmaBufferDescriptors[0];
+}
+
+bool I2S::useInterrupt()
+{ 
+	return false; 
+};
+
+void I2S::getClockSetting(long *sampleRate, int *n, int *a, int *b, int *div)
+{
+	if(sampleRate)
+		*sampleRate = 2000000;
+	if(n)
+		*n = 2;
+	if(a)
+		*a = 1;
+	if(b)
+		*b = 0;
+	if(div)
+		*div = 1;
+}
+
+bool I2S::initParallelInputMode(const int *pinMap, long sampleRate, const int bitCount, int wordSelect, int baseClock)
+{
+	DEBUG_PRINTLN("I2S input is not emulated");
+	return false;
+}
+
+bool I2S::initParallelOutputMode(const int *pinMap, long sampleRate, const int bitCount, int wordSelect, int baseClock)
+{
+	return initParallelOutputMode(pinMap, 0, bitCount, sampleRate, bitCount, wordSelect, baseClock);
+}
+
+bool I2S::initParallelOutputMode(const int *pinMap, const int *pinMapBit, const int pinCount, long sampleRate, const int bitCount, int wordSelect, int baseClock)
+{
+	hostBytesPerSample = bitCount < 8 ? 1 : bitCount / 8;
+	if(sampleRate == 0)
+		getClockSetting(&sampleRate, 0, 0, 0, 0);
+	if(sampleRate > 0)
+		setAPLLClock(sampleRate, bitCount);
+	return true;
+}
+
+bool I2S::initSerialOutputMode(int dataPin, const int bitCount, int wordSelect, int baseClock, long sampleRate)
+{
+	DEBUG_PRINTLN("I2S serial output is not emulated");
+	return false;
+}
+
+void I2S::enableDAC(int selectedDACs)
+{
+	//the DAC outputs the upper byte of the 16 bit samples, they reach the sink unchanged
+}
+
+void I2S::setAPLLClock(long sampleRate, int bitCount)
+{
+	//runs at the frequency the APLL would really generate
+	apllClock = APLL::coefficients(sampleRate * 2 * (bitCount / 8));
+	hostSampleRate = apllClock.achieved / (2 * (bitCount / 8));
+}
+
+void I2S::setClock(long sampleRate, int bitCount, bool useAPLL)
+{
+	if(useAPLL)
+		setAPLLClock(sampleRate, bitCount);
+	else
+		hostSampleRate = sampleRate;
+}
+
+/// simple ringbuffer of blocks of size bytes each
+void I2S::allocateDMABuffers(int count, int bytes)
+{
+	dmaBufferDescriptorCount = count;
+	dmaBufferDescriptors = DMABufferDescriptor::allocateDescriptors(count);
+	for (int i = 0; i < dmaBufferDescriptorCount; i++)
+	{
+		dmaBufferDescriptors[i].setBuffer(DMABufferDescriptor::allocateBuffer(bytes, true), bytes);
+		if (i)
+			dmaBufferDescriptors[i - 1].next(dmaBufferDescriptors[i]);
+	}
+	dmaBufferDescriptors[dmaBufferDescriptorCount - 1].next(dmaBufferDescriptors[0]);
+}
+
+void I2S::deleteDMABuffers()
+{
+	if (!dmaBufferDescriptors)
+		return;
+	for (int i = 0; i < dmaBufferDescriptorCount; i++)
+		free(dmaBufferDescriptors[i].buffer());
+	free(dmaBufferDescriptors);
+	dmaBufferDescriptors = 0;
+	dmaBufferDescriptorCount = 0;
+}
+
+void I2S::stop()
+{
+	//nothing clears the signal in the interrupt, stop right away
+	i2sStop();
+	stopSignal = false;
+}
+
+#endif
@@ -0,0 +1,193 @@
+/*
+	Author: bitluni 2019
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://youtube.com/bitlunislab
+		https://github.com/bitluni
+		http://bitluni.net
+*/
+#pragma once
+
+//kinds of timeline segments
+enum TimelineSegment
+{
+	TimelineLines,     //whole lines of a prototype (vertical blanking, vsync)
+	TimelineHalfLines, //half lines of a prototype (composite equalizing and vertical sync pulses)
+	TimelineData       //active lines, the part after the horizontal blanking comes from the line buffers
+};
+
+//one descriptor of a compiled timeline
+struct TimelineDescriptor
+{
+	int segment;   //TimelineSegment of the run the descriptor comes from
+	int prototype; //prototype the data comes from, -1 for the lines of a data run
+	int second;    //prototype of the second half when two half lines share a descriptor, -1 otherwise
+	int line;      //line of the timeline, active line (counted over all data runs) for data descriptors
+	int part;      //-1 for a whole line, otherwise the part of the line (as many parts as descriptors per line)
+};
+
+//compiles runs of lines and half lines into DMA descriptors
+//the parts of a mergeable line are sent by a single descriptor over the whole prototype line,
+//so the prototype only needs its parts back to back (one line-sized buffer shared by the whole run).
+//lines that must stay addressable part by part (e.g. because the interrupt derives the line from the descriptor) are not mergeable
+//with one descriptor per line, consecutive half lines are paired into a line made of both halves
+//no platform dependency, so it can be exercised on the host as well
+template<int maxRuns, int maxPrototypes = 4>
+class DMATimeline
+{
+  public:
+	static const int maxDescriptorBytes = 4092;
+
+	DMATimeline()
+	{
+		clear();
+	}
+
+	void clear()
+	{
+		runCount = 0;
+		halfLineCount = 0;
+		dataLineCount = 0;
+	}
+
+	//appends whole lines showing the prototype, joins the previous run if it is alike
+	bool add(int prototype, int lines, bool mergeable)
+	{
+		return append(TimelineLines, prototype, lines, mergeable);
+	}
+
+	//appends half lines showing the prototype, joins the previous run if it is alike
+	bool addHalfLines(int prototype, int halfLines)
+	{
+		return append(TimelineHalfLines, prototype, halfLines, false);
+	}
+
+	//appends active lines, every data run starts a new one (it is where a renderer buffer begins)
+	bool addData(int lines)
+	{
+		if (lines <= 0)
+			return true;
+		if (runCount >= maxRuns)
+			return false;
+		runs[runCount].segment = TimelineData;
+		runs[runCount].prototype = -1;
+		runs[runCount].count = lines;
+		runs[runCount].mergeable = false;
+		runCount++;
+		halfLineCount += 2 * lines;
+		dataLineCount += lines;
+		return true;
+	}
+
+	int lines() const
+	{
+		return halfLineCount / 2;
+	}
+
+	int dataLines() const
+	{
+		return dataLineCount;
+	}
+
+	//a whole line fits a single descriptor
+	static bool mergeableLine(int lineBytes)
+	{
+		return lineBytes > 0 && lineBytes <= maxDescriptorBytes;
+	}
+
+	//number of descriptors, fills descriptors (if not null) with up to maxDescriptors entries starting at firstDescriptor
+	//(so a long timeline can be assigned in chunks), -1 if lines do not start at a line boundary or half lines are left unpaired
+	int compile(int descriptorsPerLine, TimelineDescriptor *descriptors = 0, int maxDescriptors = 0, int firstDescriptor = 0) const
+	{
+		int count = 0;
+		int half = 0;
+		int dataLine = 0;
+		int pending = -1;
+		for (int r = 0; r < runCount; r++)
+		{
+			const Run &run = runs[r];
+			if (run.segment == TimelineHalfLines)
+			{
+				if (descriptorsPerLine > 2)
+					return -1;
+				for (int i = 0; i < run.count; i++, half++)
+				{
+					if (descriptorsPerLine == 2)
+						emit(descriptors, firstDescriptor, maxDescriptors, count, TimelineHalfLines, run.prototype, -1, half / 2, half & 1);
+					else if (half & 1)
+						emit(descriptors, firstDescriptor, maxDescriptors, count, TimelineHalfLines, pending, run.prototype, half / 2, -1);
+					else
+						pending = run.prototype;
+				}
+				continue;
+			}
+			if (half & 1)
+				return -1;
+			for (int i = 0; i < run.count; i++, half += 2)
+			{
+				int line = run.segment == TimelineData ? dataLine++ : half / 2;
+				if (run.mergeable || descriptorsPerLine == 1)
+					emit(descriptors, firstDescriptor, maxDescriptors, count, run.segment, run.prototype, -1, line, -1);
+				else
+					for (int p = 0; p < descriptorsPerLine; p++)
+						emit(descriptors, firstDescriptor, maxDescriptors, count, run.segment, run.prototype, -1, line, p);
+			}
+		}
+		if (half & 1)
+			return -1;
+		return count;
+	}
+
+  protected:
+	struct Run
+	{
+		int segment;
+		int prototype;
+		int count; //lines, half lines for TimelineHalfLines
+		bool mergeable;
+	};
+	Run runs[maxRuns];
+	int runCount;
+	int halfLineCount;
+	int dataLineCount;
+
+	bool append(int segment, int prototype, int count, bool mergeable)
+	{
+		if (count <= 0)
+			return true;
+		if (prototype < 0 || prototype >= maxPrototypes)
+			return false;
+		if (runCount && runs[runCount - 1].segment == segment && runs[runCount - 1].prototype == prototype && runs[runCount - 1].mergeable == mergeable)
+		{
+			runs[runCount - 1].count += count;
+			halfLineCount += segment == TimelineHalfLines ? count : 2 * count;
+			return true;
+		}
+		if (runCount >= maxRuns)
+			return false;
+		runs[runCount].segment = segment;
+		runs[runCount].prototype = prototype;
+		runs[runCount].count = count;
+		runs[runCount].mergeable = mergeable;
+		runCount++;
+		halfLineCount += segment == TimelineHalfLines ? count : 2 * count;
+		return true;
+	}
+
+	static void emit(TimelineDescriptor *descriptors, int firstDescriptor, int maxDescriptors, int &count, int segment, int prototype, int second, int line, int part)
+	{
+		if (descriptors && count >= firstDescriptor && count < firstDescriptor + maxDescriptors)
+		{
+			TimelineDescriptor &t = descriptors[count - firstDescriptor];
+			t.segment = segment;
+			t.prototype = prototype;
+			t.second = second;
+			t.line = line;
+			t.part = part;
+		}
+		count++;
+	}
+};
@@ -0,0 +1,76 @@
+/*
+	Author: bitluni 2019
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://youtube.com/bitlunislab
+		https://github.com/bitluni
+		http://bitluni.net
+*/
+
+#ifndef ESP8266
+
+#include "FrameSync.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+void IRAM_ATTR FrameSync::signalFromISR(FrameSync *sync, int line)
+{
+	sync->signalLine = line;
+	sync->signalMicros = micros();
+	sync->frames++;
+	if (sync->vBlankCallback)
+		sync->vBlankCallback(sync->frames, sync->vBlankCallbackArg);
+	if (sync->semaphore)
+	{
+		BaseType_t higherPriorityTaskWoken = pdFALSE;
+		xSemaphoreGiveFromISR((SemaphoreHandle_t)sync->semaphore, &higherPriorityTaskWoken);
+		if (higherPriorityTaskWoken)
+			portYIELD_FROM_ISR();
+	}
+}
+
+static TickType_t timeoutTicks(unsigned long timeoutMs)
+{
+	return (timeoutMs == 0xffffffff) ? portMAX_DELAY : (timeoutMs + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS;
+}
+
+bool FrameSync::waitForVSync(unsigned long timeoutMs)
+{
+	if (!semaphore)
+	{
+		semaphore = xSemaphoreCreateBinary();
+		if (!semaphore)
+			return false;
+	}
+	//drop a frame signalled before the call
+	xSemaphoreTake((SemaphoreHandle_t)semaphore, 0);
+	return xSemaphoreTake((SemaphoreHandle_t)semaphore, timeoutTicks(timeoutMs)) == pdTRUE;
+}
+
+bool FrameSync::waitForFrameAfter(unsigned long frame, unsigned long timeoutMs)
+{
+	if (!semaphore)
+	{
+		semaphore = xSemaphoreCreateBinary();
+		if (!semaphore)
+			return false;
+	}
+	//the semaphore is not drained, a give left from an older frame only costs one more look at the counter
+	while (frames == frame)
+		if (xSemaphoreTake((SemaphoreHandle_t)semaphore, timeoutTicks(timeoutMs)) != pdTRUE)
+			return frames != frame;
+	return true;
+}
+
+void FrameSync::setVBlankCallback(void (*callback)(unsigned long frame, void *arg), void *arg)
+{
+	//clear the callback first so the interrupt never sees the new one with the old argument
+	vBlankCallback = 0;
+	vBlankCallbackArg = arg;
+	vBlankCallback = callback;
+}
+
+#endif
@@ -0,0 +1,69 @@
+/*
+	Author: bitluni 2019
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://youtube.com/bitlunislab
+		https://github.com/bitluni
+		http://bitluni.net
+*/
+#pragma once
+#include "Arduino.h"
+
+//frame counter and vertical sync event signalled from the video interrupts
+class FrameSync
+{
+  public:
+	FrameSync()
+	{
+		frames = 0;
+		signalLine = -1;
+		signalMicros = 0;
+		semaphore = 0;
+		vBlankCallback = 0;
+		vBlankCallbackArg = 0;
+	}
+
+	//called by the interrupt once per frame, right after the last line of the frame was handed to the DMA
+	//line is the frame line the DMA just finished when the interrupt was raised (-1 if unknown)
+	static void IRAM_ATTR signalFromISR(FrameSync *sync, int line = -1);
+
+	unsigned long frameCount() const
+	{
+		return frames;
+	}
+
+	//blocks the calling task until the next frame is signalled, the cpu is free meanwhile
+	//returns false if no frame came within timeoutMs
+	bool waitForVSync(unsigned long timeoutMs = 0xffffffff);
+
+	//blocks until frameCount() moved past frame (read before checking what to wait for)
+	//a signal between reading frame and the call is not lost, returns false on timeout
+	bool waitForFrameAfter(unsigned long frame, unsigned long timeoutMs = 0xffffffff);
+
+	//line finished and time (micros()) of the last signal, false if there was none
+	bool getLastSignal(int &line, unsigned long &us) const
+	{
+		unsigned long f;
+		do
+		{
+			f = frames;
+			line = signalLine;
+			us = signalMicros;
+		} while (f != frames);
+		return line >= 0;
+	}
+
+	//the callback runs inside the interrupt: it has to be short and placed in IRAM
+	void setVBlankCallback(void (*callback)(unsigned long frame, void *arg), void *arg = 0);
+
+  protected:
+	volatile unsigned long frames;
+	volatile int signalLine;
+	volatile unsigned long signalMicros;
+	void *volatile semaphore;
+	void (*volatile vBlankCallback)(unsigned long frame, void *arg);
+	void *volatile vBlankCallbackArg;
+};
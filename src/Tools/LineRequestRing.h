@@ -0,0 +1,76 @@
+/*
+	Author: bitluni 2019
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://youtube.com/bitlunislab
+		https://github.com/bitluni
+		http://bitluni.net
+*/
+#pragma once
+#include <stdint.h>
+
+//a line the interrupt needs converted into a DMA line buffer
+struct LineRequest
+{
+	int line;        //line of the frame (including blanking) the buffer will be sent as
+	int y;           //row of the frame buffer to convert
+	uint8_t *pixels; //data part of the DMA line buffer
+};
+
+//lock-free ring for exactly one producer (the interrupt) and one consumer (the render task)
+//no platform dependency, so it can be exercised on the host as well
+//capacity must be a power of two
+template<class Item, int capacity>
+class LineRequestRing
+{
+  public:
+	LineRequestRing()
+	{
+		clear();
+	}
+
+	//only valid while neither side is running
+	void clear()
+	{
+		head = 0;
+		tail = 0;
+	}
+
+	__attribute__((always_inline)) inline bool push(const Item &item)
+	{
+		unsigned int h = head;
+		if (h - tail >= (unsigned int)capacity)
+			return false;
+		items[h & (capacity - 1)] = item;
+		//the item has to be visible before the consumer sees the new head
+		__sync_synchronize();
+		head = h + 1;
+		return true;
+	}
+
+	__attribute__((always_inline)) inline bool pop(Item &item)
+	{
+		unsigned int t = tail;
+		if (t == head)
+			return false;
+		__sync_synchronize();
+		item = items[t & (capacity - 1)];
+		__sync_synchronize();
+		tail = t + 1;
+		return true;
+	}
+
+	int size() const
+	{
+		return (int)(head - tail);
+	}
+
+  protected:
+	static_assert((capacity & (capacity - 1)) == 0, "LineRequestRing capacity must be a power of two");
+	volatile unsigned int head;
+	volatile unsigned int tail;
+	Item items[capacity];
+};
@@ -0,0 +1,129 @@
+/*
+	Author: bitluni 2019
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://youtube.com/bitlunislab
+		https://github.com/bitluni
+		http://bitluni.net
+*/
+#pragma once
+
+//decides which lines an interrupt renders ahead of the beam
+//the interrupt raised after a line was sent renders every line up to renderAheadLines past it
+//that was not rendered yet, lines lost to skipped interrupts are counted in missedLines
+//the window grows by a line when the consumer reports a late line (requestGrow, e.g. from a render task)
+//and shrinks back by a line towards its initial size after shrinkAfterFrames frames without one
+//no platform dependency, so it can be exercised on the host as well
+class LineScheduler
+{
+  public:
+	int totalLines; // lines of the frame (the ring of DMA lines)
+	int lineBatchCount; // lines sent between two interrupts
+	int renderAheadLines; // current window
+	int minRenderAheadLines; // window the tuning shrinks back to
+	int maxRenderAheadLines; // line buffers available
+	int shrinkAfterFrames;
+	int renderedLine; // last line rendered ahead
+	volatile unsigned long missedLines; // lines whose interrupt was skipped
+	volatile bool growRequested;
+
+	//result of schedule(): lines lastLine - pendingLines + 1 ... lastLine are to be rendered,
+	//the first repeatedLines of them may repeat the line above instead
+	int lastLine;
+	int pendingLines;
+	int repeatedLines;
+
+	LineScheduler()
+	{
+		start(1, 1, 1, 1);
+	}
+
+	//the initial content of the line buffers covers the first window
+	void start(int totalLines, int lineBatchCount, int renderAheadLines, int maxRenderAheadLines)
+	{
+		this->totalLines = totalLines < 1 ? 1 : totalLines;
+		this->lineBatchCount = lineBatchCount < 1 ? 1 : lineBatchCount;
+		if (maxRenderAheadLines < 1) maxRenderAheadLines = 1;
+		if (renderAheadLines < 1 || renderAheadLines > maxRenderAheadLines) renderAheadLines = maxRenderAheadLines;
+		this->renderAheadLines = renderAheadLines;
+		this->minRenderAheadLines = renderAheadLines;
+		this->maxRenderAheadLines = maxRenderAheadLines;
+		shrinkAfterFrames = 60;
+		renderedLine = renderAheadLines - 1;
+		missedLines = 0;
+		growRequested = false;
+		quietLines = 0;
+		lastLine = renderedLine;
+		pendingLines = 0;
+		repeatedLines = 0;
+	}
+
+	//a line was converted too close to the beam
+	void requestGrow()
+	{
+		growRequested = true;
+	}
+
+	//called once per interrupt with the line just sent
+	__attribute__((always_inline)) inline void schedule(int currentLine)
+	{
+		//a grown window adds one line that was not missed
+		int grownLines = 0;
+		if (growRequested)
+		{
+			growRequested = false;
+			quietLines = 0;
+			if (renderAheadLines < maxRenderAheadLines)
+			{
+				renderAheadLines++;
+				grownLines = 1;
+			}
+		}
+		else if (renderAheadLines > minRenderAheadLines)
+		{
+			//the beam moves at least a line per interrupt, so one line less never goes behind renderedLine
+			quietLines += lineBatchCount;
+			if (quietLines >= shrinkAfterFrames * totalLines)
+			{
+				quietLines = 0;
+				renderAheadLines--;
+			}
+		}
+
+		//render ahead every line not rendered yet
+		//this is lineBatchCount lines, unless interrupts were skipped (e.g. during wifi activity)
+		lastLine = currentLine + renderAheadLines;
+		pendingLines = (lastLine - renderedLine + totalLines) % totalLines;
+		if (pendingLines > lineBatchCount + grownLines)
+			missedLines += pendingLines - lineBatchCount - grownLines;
+		//the next line is already being sent, older ones are lost
+		if (pendingLines > renderAheadLines - 1)
+			pendingLines = renderAheadLines - 1;
+		//past the budget of two batches the oldest lines repeat the line above instead of being converted
+		repeatedLines = pendingLines - 2 * lineBatchCount;
+	}
+
+	//i-th line to render (oldest first) as a line of the frame
+	__attribute__((always_inline)) inline int line(int i) const
+	{
+		int l = lastLine - pendingLines + 1 + i;
+		return (l >= totalLines) ? l - totalLines : l;
+	}
+
+	__attribute__((always_inline)) inline bool repeats(int i) const
+	{
+		return i < repeatedLines;
+	}
+
+	//all the scheduled lines were rendered
+	__attribute__((always_inline)) inline void finish()
+	{
+		renderedLine = (lastLine >= totalLines) ? lastLine - totalLines : lastLine;
+	}
+
+  protected:
+	int quietLines; // lines sent since the window last grew
+};
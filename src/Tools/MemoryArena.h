@@ -0,0 +1,204 @@
+/*
+	Author: bitluni 2019
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://youtube.com/bitlunislab
+		https://github.com/bitluni
+		http://bitluni.net
+*/
+#pragma once
+#include "Log.h"
+
+//hands out rows (frame buffer rows, DMA lines...) carved from a few large blocks instead of one allocation each
+//every block is as large as the rows still asked for, halved until the heap can provide it
+//the rows of a block follow each other at a fixed stride, nothing is freed until release()
+//reset() keeps the blocks for the next allocations (e.g. a mode switch), only the missing memory is allocated
+//trim() gives back the kept blocks the next allocations did not need
+class MemoryArena
+{
+  public:
+	static const int maxBlocks = 32;
+
+	MemoryArena(bool dma = false)
+	{
+		this->dma = dma;
+		blockCount = 0;
+		activeBlock = -1;
+		blockFree = 0;
+		blockFreeBytes = 0;
+		reservedBytes = 0;
+		usedBytes = 0;
+		allocations = 0;
+	}
+
+	~MemoryArena()
+	{
+		release();
+	}
+
+	//count rows of bytes each (rounded up to words), false if the memory ran out
+	bool allocateRows(void **rows, int count, int bytes, bool clear = true, unsigned long clearValue = 0)
+	{
+		bytes = (bytes + 3) & 0xfffffffc;
+		int y = 0;
+		while (y < count)
+		{
+			if (blockFreeBytes < bytes && !reuseBlock(bytes) && !allocateBlock(count - y, bytes))
+				return false;
+			while (y < count && blockFreeBytes >= bytes)
+			{
+				rows[y++] = blockFree;
+				if (clear)
+					for (int i = 0; i < bytes / 4; i++)
+						((uint32_t *)blockFree)[i] = clearValue;
+				blockFree += bytes;
+				blockFreeBytes -= bytes;
+				usedBytes += bytes;
+				blockUsed[activeBlock] = true;
+			}
+		}
+		allocations++;
+		return true;
+	}
+
+	void *allocate(int bytes, bool clear = true, unsigned long clearValue = 0)
+	{
+		void *p = 0;
+		if (!allocateRows(&p, 1, bytes, clear, clearValue))
+			return 0;
+		return p;
+	}
+
+	//every pointer handed out becomes invalid, the blocks are carved again from the start
+	void reset()
+	{
+		for (int i = 0; i < blockCount; i++)
+			blockUsed[i] = false;
+		activeBlock = -1;
+		blockFree = 0;
+		blockFreeBytes = 0;
+		usedBytes = 0;
+		allocations = 0;
+	}
+
+	//frees the blocks no row was carved from since reset(), the rows handed out stay valid
+	void trim()
+	{
+		int kept = 0;
+		int active = -1;
+		for (int i = 0; i < blockCount; i++)
+		{
+			if (!blockUsed[i] && i != activeBlock)
+			{
+				free(blocks[i]);
+				reservedBytes -= blockBytes[i];
+				continue;
+			}
+			if (i == activeBlock)
+				active = kept;
+			blocks[kept] = blocks[i];
+			blockBytes[kept] = blockBytes[i];
+			blockUsed[kept++] = blockUsed[i];
+		}
+		blockCount = kept;
+		activeBlock = active;
+	}
+
+	//more than half of the reserved memory is spare (e.g. the single block of a larger mode)
+	bool oversized() const
+	{
+		unsigned long spare = reservedBytes - usedBytes;
+		return spare > usedBytes && spare > 4096;
+	}
+
+	//frees all blocks, every pointer handed out becomes invalid
+	void release()
+	{
+		for (int i = 0; i < blockCount; i++)
+			free(blocks[i]);
+		blockCount = 0;
+		activeBlock = -1;
+		blockFree = 0;
+		blockFreeBytes = 0;
+		reservedBytes = 0;
+		usedBytes = 0;
+		allocations = 0;
+	}
+
+	int getBlockCount() const { return blockCount; }
+	unsigned long getReservedBytes() const { return reservedBytes; }
+	unsigned long getUsedBytes() const { return usedBytes; }
+	int getAllocationCount() const { return allocations; }
+
+	void printStats() const
+	{
+		DEBUG_PRINT(dma ? "DMA arena: " : "Arena: ");
+		DEBUG_PRINT(allocations);
+		DEBUG_PRINT(" allocations in ");
+		DEBUG_PRINT(blockCount);
+		DEBUG_PRINT(" blocks, bytes used/reserved ");
+		DEBUG_PRINT(usedBytes);
+		DEBUG_PRINT("/");
+		DEBUG_PRINTLN(reservedBytes);
+	}
+
+  protected:
+	bool dma;
+	void *blocks[maxBlocks];
+	int blockBytes[maxBlocks];
+	bool blockUsed[maxBlocks];
+	int blockCount;
+	int activeBlock;
+	uint8_t *blockFree;
+	int blockFreeBytes;
+	unsigned long reservedBytes;
+	unsigned long usedBytes;
+	int allocations;
+
+	//continues in the next block kept by reset() that holds at least one row
+	bool reuseBlock(int bytes)
+	{
+		while (activeBlock + 1 < blockCount)
+		{
+			activeBlock++;
+			if (blockBytes[activeBlock] < bytes)
+				continue;
+			blockFree = (uint8_t *)blocks[activeBlock];
+			blockFreeBytes = blockBytes[activeBlock];
+			return true;
+		}
+		return false;
+	}
+
+	//the tail of the previous block is abandoned, it is smaller than a row
+	bool allocateBlock(int rows, int bytes)
+	{
+		if (blockCount >= maxBlocks)
+			return false;
+		void *block = 0;
+		while (rows > 0)
+		{
+			#ifdef ESP32
+			block = heap_caps_malloc(rows * bytes, dma ? MALLOC_CAP_DMA : MALLOC_CAP_8BIT);
+			#else
+			block = malloc(rows * bytes);
+			#endif
+			if (block || rows == 1)
+				break;
+			rows = (rows + 1) / 2;
+		}
+		if (!block)
+			return false;
+		blockBytes[blockCount] = rows * bytes;
+		blockUsed[blockCount] = false;
+		activeBlock = blockCount;
+		blocks[blockCount++] = block;
+		blockFree = (uint8_t *)block;
+		blockFreeBytes = rows * bytes;
+		reservedBytes += rows * bytes;
+		return true;
+	}
+};
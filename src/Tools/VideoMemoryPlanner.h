@@ -0,0 +1,334 @@
+/*
+	Author: bitluni 2019
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://youtube.com/bitlunislab
+		https://github.com/bitluni
+		http://bitluni.net
+*/
+#pragma once
+#include "../VGA/Mode.h"
+#include "../VGA/ScreenRegion.h"
+#include "../Composite/ModeComposite.h"
+#include "../Graphics/Font.h"
+#include "DMATimeline.h"
+
+//how an engine stores and sends its pixels
+struct VideoMemoryProfile
+{
+	//regular memory tables of the engine besides the frame buffers
+	enum Tables
+	{
+		noTables = 0,
+		attributeTextTables = 1, //packed font rows and the samples of every attribute (VGAAttributeTextI)
+		modulationTables = 2,    //phase step of every column and the color burst (composite modulation in the interrupt)
+		paletteTables = 4        //modulated levels of the palette per phase step and line parity (CompositeColorDACI)
+	};
+
+	int bytesPerSample; //DMA bytes per output sample
+	int bitsPerPixel;   //frame buffer bits per pixel (per character in the text modes)
+	int rowsPerUnit;    //frame buffer rows packed in one stored row (8 in the 1 bit modes)
+	bool framesInDMA;   //the frame buffers are the DMA lines (modes without interrupt conversion)
+	int cyclesPerWord;  //rough interrupt cost to convert one 32 bit output word (0 without conversion)
+	bool repeatsPixels; //the conversion honors hDiv, the frame buffer gets narrower
+	int tables;         //Tables the engine allocates
+	int charWidth;      //text modes: the frame buffer holds a character per cell of this size (0 in the pixel modes)
+	int charHeight;
+
+	VideoMemoryProfile(int bytesPerSample, int bitsPerPixel, int rowsPerUnit, bool framesInDMA, int cyclesPerWord, bool repeatsPixels = true, int tables = noTables)
+		: bytesPerSample(bytesPerSample),
+		  bitsPerPixel(bitsPerPixel),
+		  rowsPerUnit(rowsPerUnit),
+		  framesInDMA(framesInDMA),
+		  cyclesPerWord(cyclesPerWord),
+		  repeatsPixels(repeatsPixels),
+		  tables(tables),
+		  charWidth(0),
+		  charHeight(0)
+	{
+	}
+
+	VideoMemoryProfile &text(const Font &font)
+	{
+		charWidth = font.charWidth;
+		charHeight = font.charHeight;
+		return *this;
+	}
+
+	static VideoMemoryProfile VGA14Bit()    { return VideoMemoryProfile(2, 16, 1, true, 0); }
+	static VideoMemoryProfile VGA8BitDAC()  { return VideoMemoryProfile(2, 16, 1, true, 0); }
+	static VideoMemoryProfile VGA6Bit()     { return VideoMemoryProfile(1, 8, 1, true, 0); }
+	static VideoMemoryProfile VGA3Bit()     { return VideoMemoryProfile(1, 8, 1, true, 0); }
+	static VideoMemoryProfile VGA14BitI()   { return VideoMemoryProfile(2, 16, 1, false, 6); }
+	static VideoMemoryProfile VGA8BitDACI() { return VideoMemoryProfile(2, 8, 1, false, 10, false); }
+	static VideoMemoryProfile VGA6BitI()    { return VideoMemoryProfile(1, 8, 1, false, 12); }
+	static VideoMemoryProfile VGA3BitI()    { return VideoMemoryProfile(1, 4, 1, false, 12); }
+	static VideoMemoryProfile VGA1BitI()    { return VideoMemoryProfile(1, 1, 8, false, 14); }
+	//the text modes need the font set before init
+	static VideoMemoryProfile VGATextI(const Font &font)          { return VideoMemoryProfile(1, 8, 1, false, 12, false).text(font); }
+	static VideoMemoryProfile VGAAttributeTextI(const Font &font) { return VideoMemoryProfile(1, 16, 1, false, 8, false, attributeTextTables).text(font); }
+
+	static VideoMemoryProfile CompositeGrayDAC()     { return VideoMemoryProfile(2, 16, 1, true, 0); }
+	static VideoMemoryProfile CompositeGrayLadder()  { return VideoMemoryProfile(1, 8, 1, true, 0); }
+	static VideoMemoryProfile CompositeGrayDACI()    { return VideoMemoryProfile(2, 8, 1, false, 6); }
+	static VideoMemoryProfile CompositeGrayLadderI() { return VideoMemoryProfile(1, 8, 1, false, 8); }
+	static VideoMemoryProfile CompositeColorDACI()   { return VideoMemoryProfile(2, 8, 1, false, 16, true, modulationTables | paletteTables); }
+	static VideoMemoryProfile CompositeTextDACI(const Font &font) { return VideoMemoryProfile(2, 8, 1, false, 16, true, modulationTables).text(font); }
+};
+
+//memory an engine allocates in init, following VGAI2SEngine, CompositeI2SEngine and Graphics
+struct VideoMemoryPlan
+{
+	static const int descriptorSize = 12; //sizeof(lldesc_t)
+
+	int descriptorCount;            //negative if the half lines of a composite mode do not pair up (the engine refuses the mode)
+	unsigned long descriptorBytes;  //DMA capable
+	unsigned long dmaBufferBytes;   //DMA capable: prototype lines and line buffers (the frame buffers in the DMA modes)
+	unsigned long frameBufferBytes; //regular: rows and row tables
+	unsigned long tableBytes;       //regular: the Tables of the profile and the line tables of the screen regions
+	unsigned long isrCyclesPerLine; //estimated conversion cost, 0 without interrupt conversion
+
+	unsigned long dmaBytes() const
+	{
+		return descriptorBytes + dmaBufferBytes;
+	}
+
+	unsigned long regularBytes() const
+	{
+		return frameBufferBytes + tableBytes;
+	}
+
+	unsigned long totalBytes() const
+	{
+		return dmaBytes() + regularBytes();
+	}
+
+	//VGA, the screen regions are the ones given to addRegion (completed to the mode as the engine does)
+	//lineBufferCount 0 selects the default of the interrupt modes (3 lines, twice the batch if larger)
+	static VideoMemoryPlan compute(const VideoMemoryProfile &profile, const Mode &mode, int frameBufferCount = 1, int lineBufferCount = 0, int lineBatchCount = 1,
+		const ScreenRegion *addedRegions = 0, int addedRegionCount = 0)
+	{
+		VideoMemoryPlan plan;
+		int sizeHLineComplete = mode.pixelsPerLine() * profile.bytesPerSample;
+		int sizeHBlanking = (mode.hFront + mode.hSync + mode.hBack) * profile.bytesPerSample;
+		int sizeHData = mode.hRes * profile.bytesPerSample;
+		int descriptorsPerLine = profile.framesInDMA ? 2 : 1;
+		int rendererBufferCount = profile.framesInDMA ? frameBufferCount : 1;
+
+		//frame buffer rows, the ones of static regions are shared by the renderer buffers
+		int hDiv = sentHDiv(profile, mode, mode.hDiv, 1);
+		ScreenRegion regions[ScreenRegion::maxCount];
+		bool cut;
+		int regionCount = ScreenRegion::complete(regions, addedRegions, addedRegionCount, mode.vRes, cut);
+		int rows = regionCount ? 0 : mode.vRes / mode.vDiv;
+		int sharedRows = 0;
+		int frameHDiv = hDiv;
+		for (int r = 0; r < regionCount; r++)
+		{
+			int vDiv = regions[r].vDiv > 0 ? regions[r].vDiv : mode.vDiv;
+			int regionRows = (regions[r].lines + vDiv - 1) / vDiv;
+			int regionHDiv = sentHDiv(profile, mode, regions[r].hDiv, hDiv);
+			rows += regionRows;
+			if (regions[r].bufferCount == 1)
+				sharedRows += regionRows;
+			if (!r || regionHDiv < frameHDiv)
+				frameHDiv = regionHDiv;
+		}
+		if (!profile.framesInDMA && lineBufferCount <= 0)
+			lineBufferCount = (2 * lineBatchCount > 3) ? 2 * lineBatchCount : 3;
+		if (profile.framesInDMA)
+			lineBufferCount = rows;
+
+		//vertical blanking, a descriptor per line only in the modes that raise a single interrupt per frame
+		bool merge = profile.framesInDMA && (sizeHBlanking & 3) == 0 && DMATimeline<1>::mergeableLine(sizeHLineComplete);
+		DMATimeline<6, 2> timeline;
+		timeline.add(0, mode.vFront, merge);
+		timeline.add(1, mode.vSync, merge);
+		timeline.add(0, mode.vBack, merge);
+		for (int b = 0; b < rendererBufferCount; b++)
+			timeline.addData(mode.vRes);
+		plan.setDescriptors(timeline.compile(descriptorsPerLine));
+
+		plan.dmaBufferBytes = 0;
+		if (descriptorsPerLine == 2)
+		{
+			//merged prototypes keep their parts back to back
+			if (merge)
+				plan.dmaBufferBytes += 2 * (sizeHBlanking + aligned(sizeHData));
+			else
+				plan.dmaBufferBytes += 2 * (aligned(sizeHBlanking) + aligned(sizeHData));
+			int dataLines = lineBufferCount + (rendererBufferCount - 1) * (lineBufferCount - sharedRows);
+			plan.dmaBufferBytes += (unsigned long)dataLines * aligned(sizeHData);
+		}
+		else
+		{
+			plan.dmaBufferBytes += 2 * aligned(sizeHLineComplete);
+			plan.dmaBufferBytes += (unsigned long)rendererBufferCount * lineBufferCount * aligned(sizeHLineComplete);
+		}
+
+		plan.addFrameBuffers(profile, frameBufferCount, mode.hRes / frameHDiv, rows, mode.hRes, mode.vRes / mode.vDiv);
+		plan.addTables(profile, mode.hRes, -1, 1);
+		//the interrupt modes look the row and divider of every line up with regions
+		if (regionCount && !profile.framesInDMA)
+			plan.tableBytes += (unsigned long)mode.vRes * 2 + rows;
+
+		plan.isrCyclesPerLine = (unsigned long)profile.cyclesPerWord * sizeHData / 4;
+		return plan;
+	}
+
+	//composite, the half line timeline of CompositeI2SEngine
+	static VideoMemoryPlan compute(const VideoMemoryProfile &profile, const ModeComposite &mode, int frameBufferCount = 1, int lineBufferCount = 0, int lineBatchCount = 1)
+	{
+		VideoMemoryPlan plan;
+		int rows = mode.vRes / mode.vDiv;
+		int sizeHLineComplete = mode.pixelsPerLine() * profile.bytesPerSample;
+		int sizeHalfLine = (mode.pixelsPerLine() / 2) * profile.bytesPerSample;
+		int sizeHData = mode.hRes * profile.bytesPerSample;
+		int descriptorsPerLine = profile.framesInDMA ? 2 : 1;
+		int rendererBufferCount = profile.framesInDMA ? frameBufferCount : 1;
+		if (!profile.framesInDMA && lineBufferCount <= 0)
+			lineBufferCount = (2 * lineBatchCount > 3) ? 2 * lineBatchCount : 3;
+		if (profile.framesInDMA)
+			lineBufferCount = rows;
+
+		//the fields with their sync half lines, the normal lines are merged in the modes that raise a single interrupt per frame
+		bool merge = profile.framesInDMA && (sizeHalfLine & 3) == 0 && DMATimeline<1>::mergeableLine(2 * sizeHalfLine);
+		DMATimeline<24, 5> timeline;
+		addField(timeline, mode, mode.vOPreRegHL, mode.vOPostRegHL, merge);
+		if (mode.interlaced)
+			addField(timeline, mode, mode.vEPreRegHL, mode.vEPostRegHL, merge);
+		for (int f = mode.interlaced ? 2 : 1; f > 0; f--)
+			for (int b = 1; b < rendererBufferCount; b++)
+				timeline.addData(mode.vActive);
+		plan.setDescriptors(timeline.compile(descriptorsPerLine));
+
+		if (descriptorsPerLine == 2)
+		{
+			//the data part of a blanking line and the 4 half line prototypes (merged ones are word sized already)
+			plan.dmaBufferBytes = aligned(sizeHData) + 4 * aligned(sizeHalfLine);
+			plan.dmaBufferBytes += (unsigned long)rendererBufferCount * lineBufferCount * aligned(sizeHData);
+		}
+		else
+		{
+			//the blanking line and the sync lines, concatenated half lines if the line splits into words
+			plan.dmaBufferBytes = aligned(sizeHLineComplete);
+			plan.dmaBufferBytes += (sizeHLineComplete % 8 == 0) ? 7 * (unsigned long)sizeHalfLine : 6 * aligned(sizeHLineComplete);
+			plan.dmaBufferBytes += (unsigned long)lineBufferCount * aligned(sizeHLineComplete);
+		}
+
+		plan.addFrameBuffers(profile, frameBufferCount, mode.hRes, rows, mode.hRes, rows);
+		plan.addTables(profile, mode.hRes, mode.colorClock ? mode.burstLength : -1, (mode.colorClock && mode.phaseAlternating) ? 2 : 1);
+
+		plan.isrCyclesPerLine = (unsigned long)profile.cyclesPerWord * sizeHData / 4;
+		return plan;
+	}
+
+	//largest configuration fitting the heap: the lowest vDiv (from the one of the mode) first, then the most frame buffers
+	//dmaHeapBytes limits the DMA capable part on its own (0 if it comes from the same heap without further limit)
+	template<class ModeType>
+	static bool recommend(const VideoMemoryProfile &profile, const ModeType &mode, unsigned long heapBytes, unsigned long dmaHeapBytes,
+		int &frameBufferCount, int &vDiv, int maxFrameBufferCount = 3, int maxVDiv = 8)
+	{
+		for (int d = mode.vDiv; d <= maxVDiv; d++)
+		{
+			if (mode.vRes % d)
+				continue;
+			ModeType divided = mode;
+			divided.vDiv = d;
+			for (int f = maxFrameBufferCount; f >= 1; f--)
+			{
+				VideoMemoryPlan plan = compute(profile, divided, f);
+				if (plan.totalBytes() > heapBytes || (dmaHeapBytes && plan.dmaBytes() > dmaHeapBytes))
+					continue;
+				frameBufferCount = f;
+				vDiv = d;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	template<class Output>
+	void print(Output &output) const
+	{
+		output.print("DMA descriptors: ");
+		output.print(descriptorCount);
+		output.print(" (");
+		output.print(descriptorBytes);
+		output.println(" bytes)");
+		output.print("DMA buffers: ");
+		output.println(dmaBufferBytes);
+		output.print("Frame buffers: ");
+		output.println(frameBufferBytes);
+		output.print("Tables: ");
+		output.println(tableBytes);
+		output.print("Total: ");
+		output.println(totalBytes());
+		output.print("Interrupt cycles per line (estimate): ");
+		output.println(isrCyclesPerLine);
+	}
+
+  protected:
+	static unsigned long aligned(int bytes)
+	{
+		return (unsigned long)((bytes + 3) & 0xfffffffc);
+	}
+
+	//the divider the engine keeps (fallback if there is none or the engine ignores it)
+	static int sentHDiv(const VideoMemoryProfile &profile, const Mode &mode, int hDiv, int fallback)
+	{
+		if (hDiv == 1 || (hDiv > 1 && !profile.framesInDMA && profile.repeatsPixels && mode.hRes % hDiv == 0))
+			return hDiv;
+		return fallback;
+	}
+
+	static void addField(DMATimeline<24, 5> &timeline, const ModeComposite &mode, int preRegHL, int postRegHL, bool merge)
+	{
+		//prototypes as in CompositeI2SEngine: normal line, NF, NB, EQ, SY half lines
+		timeline.add(0, mode.vFront + preRegHL / 2, merge);
+		timeline.addHalfLines(1, preRegHL & 1);
+		timeline.addHalfLines(3, mode.vPreEqHL);
+		timeline.addHalfLines(4, mode.vSyncHL);
+		timeline.addHalfLines(3, mode.vPostEqHL);
+		timeline.addHalfLines(2, postRegHL & 1);
+		timeline.add(0, postRegHL / 2 + mode.vBack, merge);
+		timeline.addData(mode.vActive);
+	}
+
+	void setDescriptors(int count)
+	{
+		descriptorCount = count;
+		descriptorBytes = count > 0 ? (unsigned long)count * descriptorSize : 0;
+	}
+
+	//the row tables, and the rows themselves unless they are the DMA lines
+	//the text modes size their cells from the active area (textWidth by textHeight pixels)
+	void addFrameBuffers(const VideoMemoryProfile &profile, int frameBufferCount, int xres, int yres, int textWidth, int textHeight)
+	{
+		if (profile.charWidth)
+		{
+			xres = (textWidth + profile.charWidth - 1) / profile.charWidth;
+			yres = (textHeight + profile.charHeight - 1) / profile.charHeight;
+		}
+		int storedRows = (yres + profile.rowsPerUnit - 1) / profile.rowsPerUnit;
+		unsigned long rowBytes = aligned((xres * profile.bitsPerPixel * profile.rowsPerUnit + 7) / 8);
+		frameBufferBytes = (unsigned long)frameBufferCount * storedRows * 4;
+		if (!profile.framesInDMA)
+			frameBufferBytes += (unsigned long)frameBufferCount * storedRows * rowBytes;
+	}
+
+	//burstLength -1 without color burst
+	void addTables(const VideoMemoryProfile &profile, int hRes, int burstLength, int lineParities)
+	{
+		tableBytes = 0;
+		if (profile.tables & VideoMemoryProfile::attributeTextTables)
+			tableBytes += (unsigned long)profile.charHeight * 256 * 2 + 256 * 16 * 4;
+		if (profile.tables & VideoMemoryProfile::modulationTables)
+			tableBytes += hRes + (burstLength >= 0 ? 2 * burstLength + 1 : 0);
+		if (profile.tables & VideoMemoryProfile::paletteTables)
+			tableBytes += (unsigned long)lineParities * 256 * 32;
+	}
+};
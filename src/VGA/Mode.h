@@ -27,6 +27,7 @@ class Mode
 	int hSyncPolarity;
 	int vSyncPolarity;
 	float aspect;
+	int hDiv; // samples per frame buffer pixel, divides hRes (only in modes converting lines in the interrupt)
 	int activeLineCount; // calculated: actual information for lines displayed
 	Mode(
 		const int hFront = 0,
@@ -41,7 +42,8 @@ class Mode
 		const unsigned long pixelClock = 0,
 		const int hSyncPolarity = 1,
 		const int vSyncPolarity = 1,
-		const float aspect = 1.f)
+		const float aspect = 1.f,
+		const int hDiv = 1)
 		: hFront(hFront),
 		  hSync(hSync),
 		  hBack(hBack),
@@ -55,6 +57,7 @@ class Mode
 		  hSyncPolarity(hSyncPolarity),
 		  vSyncPolarity(vSyncPolarity),
 		  aspect(aspect),
+		  hDiv(hDiv),
 		  activeLineCount(vRes / vDiv)
 	{
 	}
@@ -74,9 +77,11 @@ class Mode
 		return hFront + hSync + hBack + hRes;
 	}
 
-	Mode custom(int xres, int yres, int fixedYDivider = 0) const
+	//fixedXDivider keeps the pixel clock up (xres * fixedXDivider samples per line) and repeats every pixel
+	Mode custom(int xres, int yres, int fixedYDivider = 0, int fixedXDivider = 1) const
 	{
-		xres = (xres + 3) & 0xfffffffc;
+		int hd = fixedXDivider > 1 ? fixedXDivider : 1;
+		xres = ((xres + 3) & 0xfffffffc) * hd;
 		float f = float(xres) / hRes;
 		int hs = int(hSync * f + 3) & 0xfffffffc;
 		int hb = int((hSync + hBack - hs / f) * f + 3) & 0xfffffffc;
@@ -88,7 +93,7 @@ class Mode
 		int vf = vFront + vRes / 2 - vr / 2;
 		int vb = vBack + vRes / 2 - (vr - vr / 2);
 		long pc = long(pixelClock * f);
-		return Mode(hf, hs, hb, hr, vf, vSync, vb, vr, vd, pc, hSyncPolarity, vSyncPolarity);
+		return Mode(hf, hs, hb, hr, vf, vSync, vb, vr, vd, pc, hSyncPolarity, vSyncPolarity, 1.f, hd);
 	}
 
 	template<class Output>
@@ -112,6 +117,8 @@ class Mode
 		output.println(vRes);
 		output.print("vDiv: ");
 		output.println(vDiv);
+		output.print("hDiv: ");
+		output.println(hDiv);
 		output.print("pixelClock: ");
 		output.println(pixelClock);
 		output.print("hSyncPolarity: ");
@@ -0,0 +1,58 @@
+/*
+	Author: bitluni 2019
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://youtube.com/bitlunislab
+		https://github.com/bitluni
+		http://bitluni.net
+*/
+#pragma once
+
+// horizontal band of the active area with its own buffering and dividers
+struct ScreenRegion
+{
+	static const int maxCount = 8;
+
+	int lines;       // display lines covered (in units of mode.vRes)
+	int bufferCount; // 1: the rows are shared by all renderer buffers (static content), otherwise as many as frame buffers
+	int vDiv;        // display lines per frame buffer row, 0 for mode.vDiv
+	int hDiv;        // samples per frame buffer pixel, 0 for mode.hDiv (only in modes converting lines in the interrupt)
+	int scroll;      // rows the content is rotated up (hardware scroll, no pixel is moved)
+
+	//the regions of a mode: the added ones cut or completed to cover the active lines exactly
+	//returns the number of regions (0 without added regions), cut tells the added ones exceeded the lines
+	static int complete(ScreenRegion *regions, const ScreenRegion *addedRegions, int addedRegionCount, int activeLines, bool &cut)
+	{
+		int regionCount = 0;
+		int lines = 0;
+		cut = false;
+		for (int r = 0; r < addedRegionCount && lines < activeLines; r++)
+		{
+			ScreenRegion &region = regions[regionCount++];
+			region = addedRegions[r];
+			if (lines + region.lines > activeLines)
+			{
+				cut = true;
+				region.lines = activeLines - lines;
+			}
+			lines += region.lines;
+		}
+		if (!regionCount || lines == activeLines)
+			return regionCount;
+		if (regionCount == maxCount)
+		{
+			regions[regionCount - 1].lines += activeLines - lines;
+			return regionCount;
+		}
+		ScreenRegion &region = regions[regionCount++];
+		region.lines = activeLines - lines;
+		region.bufferCount = 0;
+		region.vDiv = 0;
+		region.hDiv = 0;
+		region.scroll = 0;
+		return regionCount;
+	}
+};
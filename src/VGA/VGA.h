@@ -13,6 +13,7 @@
 
 #include "Mode.h"
 #include "PinConfig.h"
+#include "../Tools/FrameSync.h"
 
 // for back compatibility reasons, allow recalling "pre-configured" modes and PinConfigs within the class
 // it might be deprecated in a major version increase
@@ -39,10 +40,109 @@ class VGA : public VGAMode, public VGAPinConfig
 
 	int getCurrentLine(){ return currentLine; }
 
+	//frames signalled by the interrupt since init
+	unsigned long frameCount() const { return frameSync.frameCount(); }
+	//blocks until the next frame starts, letting other tasks (or the idle task) use the cpu
+	bool waitForVSync(unsigned long timeoutMs = 0xffffffff) { return frameSync.waitForVSync(timeoutMs); }
+	//called from the interrupt once per frame (keep it short and in IRAM)
+	void setVBlankCallback(void (*callback)(unsigned long frame, void *arg), void *arg = 0) { frameSync.setVBlankCallback(callback, arg); }
+
+	// Racing the beam: the position is estimated from the time elapsed since the last frame signal
+
+	// line of the frame (blanking included) being sent
+	int getBeamLine() const
+	{
+		int line;
+		unsigned long us;
+		if (!frameSync.getLastSignal(line, us) || !mode.pixelClock || !totalLines)
+			return currentLine;
+		uint64_t elapsedLines = (uint64_t)(micros() - us) * mode.pixelClock / 1000000 / mode.pixelsPerLine();
+		return (int)((line + 1 + elapsedLines) % totalLines);
+	}
+
+	// frame buffer row the renderer reads now, -1 during the vertical blanking
+	// (modes converting lines in advance read ahead of the beam)
+	int getScanRow() const
+	{
+		int line = (getBeamLine() + frameBufferReadAheadLines()) % totalLines;
+		int vInactiveLinesCount = mode.vFront + mode.vSync + mode.vBack;
+		if (line < vInactiveLinesCount)
+			return -1;
+		return lineToRow(line - vInactiveLinesCount);
+	}
+
+	// rows of the current frame already read, all of them during the vertical blanking
+	int getScannedRows() const
+	{
+		int row = getScanRow();
+		return (row < 0) ? frameRows() : row;
+	}
+
+	// band (of bandRows rows) the renderer reads now, -1 during the vertical blanking
+	// chase the beam by drawing the band before it: waitForSafeRows(band * bandRows, band * bandRows + bandRows - 1)
+	int getScanBand(int bandRows) const
+	{
+		int row = getScanRow();
+		return (row < 0) ? -1 : row / bandRows;
+	}
+
+	// blocks until the rows [firstRow, lastRow] have been read in the current frame
+	// they can then be drawn tear-free in a single buffer
+	// returns the time (us) left until the next frame reaches firstRow
+	unsigned long waitForSafeRows(int firstRow, int lastRow)
+	{
+		unsigned long lineNs = (uint64_t)mode.pixelsPerLine() * 1000000000 / mode.pixelClock;
+		int vInactiveLinesCount = mode.vFront + mode.vSync + mode.vBack;
+		while (true)
+		{
+			int row = getScanRow();
+			if (row < 0 || row > lastRow)
+			{
+				// lines from the one being read to the first line of firstRow in the next frame
+				int line = (row < 0) ? (getBeamLine() + frameBufferReadAheadLines()) % totalLines : vInactiveLinesCount + rowToLine(row);
+				int lines = vInactiveLinesCount + rowToLine(firstRow) - line;
+				if (lines < 0) lines += totalLines;
+				return (unsigned long)((uint64_t)lines * lineNs / 1000);
+			}
+			unsigned long us = (unsigned long)((uint64_t)(rowToLine(lastRow + 1) - rowToLine(row)) * lineNs / 1000);
+			// sleep through most of the wait, then poll the estimate
+			if (us > 2000)
+				delay(us / 1000 - 1);
+			else
+				delayMicroseconds(us + 1);
+		}
+	}
+
+	// Rows and active lines, every row is mode.vDiv lines unless the engine splits the screen in regions
+
+	// frame buffer row sent in the active line
+	virtual int lineToRow(int line) const
+	{
+		return line / mode.vDiv;
+	}
+
+	// first active line sending the row
+	virtual int rowToLine(int row) const
+	{
+		return row * mode.vDiv;
+	}
+
+	// frame buffer rows of the whole active area
+	virtual int frameRows() const
+	{
+		return mode.vRes / mode.vDiv;
+	}
+
 	Mode mode;
 
   protected:
 
+	// lines converted in advance of the beam (only interrupt driven modes read the frame buffer early)
+	virtual int frameBufferReadAheadLines() const
+	{
+		return 0;
+	}
+
 	// This function represents the compromise to join a rendering engine with a canvas graphic buffer, and to pass geometry to the later
 	virtual void propagateResolution(const int xres, const int yres) = 0;
 
@@ -50,6 +150,7 @@ class VGA : public VGAMode, public VGAPinConfig
 	int totalLines;
 	int currentLine;
 	volatile bool vSyncPassed;
+	FrameSync frameSync;
 
 	// Functions and member variables related with sync bits
 	virtual void initSyncBits() = 0;
@@ -21,6 +21,7 @@ class VGA14BitI : public VGAI2SDynamic< BLpx1sz16sw1sh0, Graphics<ColorR5G5B4A2,
 	{
 		frontColor = 0xffff;
 		interruptStaticChild = &VGA14BitI::interrupt;
+		renderTaskPixelLine = &VGA14BitI::interruptPixelLine;
 	}
 
 	bool init(const Mode &mode, 
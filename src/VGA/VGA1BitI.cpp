@@ -15,37 +15,7 @@
 void IRAM_ATTR VGA1BitI::interrupt(void *arg)
 {
 	VGA1BitI * staticthis = (VGA1BitI *)arg;
-
-	//obtain currently rendered line from the buffer just read, based on the conventioned ordering and buffers per line
-	staticthis->currentLine = staticthis->dmaBufferDescriptorActive >> ( (staticthis->descriptorsPerLine==2) ? 1 : 0 );
-
-	//in the case of two buffers per line,
-	//render only when the sync half of the line ended (longer period until next interrupt)
-	//else exit early
-	//This might need to be revised, because it might be better to overlap and miss the second interrupt
-	if ( (staticthis->descriptorsPerLine==2) && ((staticthis->dmaBufferDescriptorActive & 1) != 0) ) return;
-
-	//TO DO: This should be precalculated outside the interrupt
-	int vInactiveLinesCount = staticthis->mode.vFront + staticthis->mode.vSync + staticthis->mode.vBack;
-
-	//render ahead (the lenght of buffered lines)
-	int renderLine = (staticthis->currentLine + staticthis->lineBufferCount);
-	if (renderLine >= staticthis->totalLines) renderLine -= staticthis->totalLines;
-
-	if (renderLine >= vInactiveLinesCount)
-	{
-		int renderActiveLine = renderLine - vInactiveLinesCount;
-		uint8_t *activeRenderingBuffer = ((uint8_t *)
-		staticthis->dmaBufferDescriptors[staticthis->indexRendererDataBuffer[0] + renderActiveLine * staticthis->descriptorsPerLine + staticthis->descriptorsPerLine - 1].buffer() + staticthis->dataOffsetInLineInBytes
-		);
-
-		int y = renderActiveLine / staticthis->mode.vDiv;
-		if (y >= 0 && y < staticthis->yres)
-			staticthis->interruptPixelLine(y, activeRenderingBuffer, arg);
-	}
-
-	if (renderLine == 0)
-		staticthis->vSyncPassed = true;
+	staticthis->renderScheduledLines(&VGA1BitI::interruptPixelLine, arg, staticthis->yres);
 }
 
 	//LOWER LIMIT: THE CODE BETWEEN THESE MARKS IS SHARED BETWEEN 3BIT, 6BIT, AND 14BIT
@@ -54,14 +24,56 @@ void IRAM_ATTR VGA1BitI::interruptPixelLine(int y, uint8_t *pixels, void *arg)
 {
 	VGA1BitI * staticthis = (VGA1BitI *)arg;
 	unsigned long syncBits = (staticthis->hsyncBitI | staticthis->vsyncBitI) * staticthis->rendererStaticReplicate32mask;
-	unsigned long *line = (unsigned long *)staticthis->frontBuffer[y >> 3];
+	uint32_t *line = (uint32_t *)staticthis->frontBuffer[y >> 3];
 	int lineBitShiftSelector = 0x7 - (y & 0x7);
-	for (int i = 0; i < staticthis->mode.hRes / 4; i++)
+	int hDiv = staticthis->rowHDiv ? staticthis->rowHDiv[y] : staticthis->mode.hDiv;
+	if (hDiv == 1)
+	{
+		for (int i = 0; i < staticthis->mode.hRes / 4; i++)
+		{
+			uint32_t pixel = (line[i] >> lineBitShiftSelector) & 0x1010101;
+			pixel = (pixel&(1<<0 | 1<<8))<<16 | (pixel&(1<<16 | 1<<24))>>16;
+			((uint32_t *)pixels)[i] = syncBits
+			 | (pixel * staticthis->frontGlobalColor)
+			 | ((pixel^0x01010101) * staticthis->backGlobalColor);
+		}
+	}
+	else if (hDiv == 2 || hDiv == 4)
+	{
+		//each word takes 4 / hDiv pixels (one byte holding 8 rows each)
+		uint8_t *lineBytes = (uint8_t *)line;
+		for (int i = 0; i < staticthis->mode.hRes / 4; i++)
+		{
+			uint32_t pixel;
+			if (hDiv == 2)
+				pixel = ((lineBytes[i * 2] >> lineBitShiftSelector) & 1) * 0x01010000
+					| ((lineBytes[i * 2 + 1] >> lineBitShiftSelector) & 1) * 0x0101;
+			else
+				pixel = ((lineBytes[i] >> lineBitShiftSelector) & 1) * 0x01010101;
+			((uint32_t *)pixels)[i] = syncBits
+			 | (pixel * staticthis->frontGlobalColor)
+			 | ((pixel^0x01010101) * staticthis->backGlobalColor);
+		}
+	}
+	else
 	{
-		uint32_t pixel = (line[i] >> lineBitShiftSelector) & 0x1010101;
-		pixel = (pixel&(1<<0 | 1<<8))<<16 | (pixel&(1<<16 | 1<<24))>>16;
-		((uint32_t *)pixels)[i] = syncBits
-		 | (pixel * staticthis->frontGlobalColor)
-		 | ((pixel^0x01010101) * staticthis->backGlobalColor);
+		//every pixel (one byte holding 8 rows) is sent hDiv times, x moves on after the last one
+		uint8_t *lineBytes = (uint8_t *)line;
+		int x = 0;
+		int repeat = hDiv;
+		for (int i = 0; i < staticthis->mode.hRes / 4; i++)
+		{
+			uint32_t pixel = ((lineBytes[x] >> lineBitShiftSelector) & 1) << 16;
+			if (--repeat == 0) { repeat = hDiv; x++; }
+			pixel |= ((lineBytes[x] >> lineBitShiftSelector) & 1) << 24;
+			if (--repeat == 0) { repeat = hDiv; x++; }
+			pixel |= ((lineBytes[x] >> lineBitShiftSelector) & 1) << 0;
+			if (--repeat == 0) { repeat = hDiv; x++; }
+			pixel |= ((lineBytes[x] >> lineBitShiftSelector) & 1) << 8;
+			if (--repeat == 0) { repeat = hDiv; x++; }
+			((uint32_t *)pixels)[i] = syncBits
+			 | (pixel * staticthis->frontGlobalColor)
+			 | ((pixel^0x01010101) * staticthis->backGlobalColor);
+		}
 	}
 }
@@ -21,6 +21,7 @@ class VGA1BitI : public VGAI2SDynamic< BLpx1sz8sw2sh0, GraphicsW1 > // GraphicsW
 	{
 		frontColor = 0xf;
 		interruptStaticChild = &VGA1BitI::interrupt;
+		renderTaskPixelLine = &VGA1BitI::interruptPixelLine;
 	}
 
 	bool init(const Mode &mode, const int RPin, const int GPin, const int BPin, const int hsyncPin, const int vsyncPin, const int clockPin = -1)
@@ -15,37 +15,7 @@
 void IRAM_ATTR VGA3BitI::interrupt(void *arg)
 {
 	VGA3BitI * staticthis = (VGA3BitI *)arg;
-
-	//obtain currently rendered line from the buffer just read, based on the conventioned ordering and buffers per line
-	staticthis->currentLine = staticthis->dmaBufferDescriptorActive >> ( (staticthis->descriptorsPerLine==2) ? 1 : 0 );
-
-	//in the case of two buffers per line,
-	//render only when the sync half of the line ended (longer period until next interrupt)
-	//else exit early
-	//This might need to be revised, because it might be better to overlap and miss the second interrupt
-	if ( (staticthis->descriptorsPerLine==2) && ((staticthis->dmaBufferDescriptorActive & 1) != 0) ) return;
-
-	//TO DO: This should be precalculated outside the interrupt
-	int vInactiveLinesCount = staticthis->mode.vFront + staticthis->mode.vSync + staticthis->mode.vBack;
-
-	//render ahead (the lenght of buffered lines)
-	int renderLine = (staticthis->currentLine + staticthis->lineBufferCount);
-	if (renderLine >= staticthis->totalLines) renderLine -= staticthis->totalLines;
-
-	if (renderLine >= vInactiveLinesCount)
-	{
-		int renderActiveLine = renderLine - vInactiveLinesCount;
-		uint8_t *activeRenderingBuffer = ((uint8_t *)
-		staticthis->dmaBufferDescriptors[staticthis->indexRendererDataBuffer[0] + renderActiveLine * staticthis->descriptorsPerLine + staticthis->descriptorsPerLine - 1].buffer() + staticthis->dataOffsetInLineInBytes
-		);
-
-		int y = renderActiveLine / staticthis->mode.vDiv;
-		if (y >= 0 && y < staticthis->yres)
-			staticthis->interruptPixelLine(y, activeRenderingBuffer, arg);
-	}
-
-	if (renderLine == 0)
-		staticthis->vSyncPassed = true;
+	staticthis->renderScheduledLines(&VGA3BitI::interruptPixelLine, arg, staticthis->yres);
 }
 
 	//LOWER LIMIT: THE CODE BETWEEN THESE MARKS IS SHARED BETWEEN 3BIT, 6BIT, AND 14BIT
@@ -55,13 +25,53 @@ void IRAM_ATTR VGA3BitI::interruptPixelLine(int y, uint8_t *pixels, void *arg)
 	VGA3BitI * staticthis = (VGA3BitI *)arg;
 	unsigned long syncBits = (staticthis->hsyncBitI | staticthis->vsyncBitI) * staticthis->rendererStaticReplicate32mask;
 	unsigned char *line = staticthis->frontBuffer[y];
+	int hDiv = staticthis->rowHDiv ? staticthis->rowHDiv[y] : staticthis->mode.hDiv;
 	int j = 0;
-	for (int i = 0; i < staticthis->mode.hRes / 4; i++)
+	if (hDiv == 1)
+	{
+		for (int i = 0; i < staticthis->mode.hRes / 4; i++)
+		{
+			int p0 = (line[j] >> 0) & 7;
+			int p1 = (line[j++] >> 4) & 7;
+			int p2 = (line[j] >> 0) & 7;
+			int p3 = (line[j++] >> 4) & 7;
+			((uint32_t *)pixels)[i] = syncBits | (p2 << 0) | (p3 << 8) | (p0 << 16) | (p1 << 24);
+		}
+	}
+	else if (hDiv == 2)
+	{
+		//the two pixels of a byte fill a word, the first one goes to the upper half
+		for (int i = 0; i < staticthis->mode.hRes / 4; i++)
+		{
+			int p0 = (line[i] >> 0) & 7;
+			int p1 = (line[i] >> 4) & 7;
+			((uint32_t *)pixels)[i] = syncBits | (p1 * 0x0101) | (p0 * 0x01010000);
+		}
+	}
+	else if (hDiv == 4)
+	{
+		for (int i = 0; i < staticthis->mode.hRes / 8; i++)
+		{
+			((uint32_t *)pixels)[i * 2] = syncBits | (((line[i] >> 0) & 7) * 0x01010101);
+			((uint32_t *)pixels)[i * 2 + 1] = syncBits | (((line[i] >> 4) & 7) * 0x01010101);
+		}
+	}
+	else
 	{
-		int p0 = (line[j] >> 0) & 7;
-		int p1 = (line[j++] >> 4) & 7;
-		int p2 = (line[j] >> 0) & 7;
-		int p3 = (line[j++] >> 4) & 7;
-		((uint32_t *)pixels)[i] = syncBits | (p2 << 0) | (p3 << 8) | (p0 << 16) | (p1 << 24);
+		//every pixel is sent hDiv times, x moves on after the last one (two pixels per byte)
+		int x = 0;
+		int repeat = hDiv;
+		for (int i = 0; i < staticthis->mode.hRes / 4; i++)
+		{
+			int p0 = (line[x >> 1] >> ((x & 1) << 2)) & 7;
+			if (--repeat == 0) { repeat = hDiv; x++; }
+			int p1 = (line[x >> 1] >> ((x & 1) << 2)) & 7;
+			if (--repeat == 0) { repeat = hDiv; x++; }
+			int p2 = (line[x >> 1] >> ((x & 1) << 2)) & 7;
+			if (--repeat == 0) { repeat = hDiv; x++; }
+			int p3 = (line[x >> 1] >> ((x & 1) << 2)) & 7;
+			if (--repeat == 0) { repeat = hDiv; x++; }
+			((uint32_t *)pixels)[i] = syncBits | (p2 << 0) | (p3 << 8) | (p0 << 16) | (p1 << 24);
+		}
 	}
 }
@@ -21,6 +21,7 @@ class VGA3BitI : public VGAI2SDynamic< BLpx1sz8sw2sh0, GraphicsR1G1B1A1 > // Gra
 	{
 		frontColor = 0xf;
 		interruptStaticChild = &VGA3BitI::interrupt;
+		renderTaskPixelLine = &VGA3BitI::interruptPixelLine;
 	}
 
 	bool init(const Mode &mode, const int RPin, const int GPin, const int BPin, const int hsyncPin, const int vsyncPin, const int clockPin = -1)
@@ -93,7 +93,7 @@ class VGA4ColorMultimonitor : public VGAI2SOverlapping<BLpx1sz16sw1sh0, Graphics
 		if(this->dmaBufferDescriptors)
 			for (int i = 0; i < this->yres * this->mode.vDiv / this->my; i++)
 				this->dmaBufferDescriptors[
-						this->indexRendererDataBuffer[(this->currentFrameBuffer + this->frameBufferCount - 1) % this->frameBufferCount]
+						this->indexRendererDataBuffer[this->backRendererBuffer()]
 						 + i * this->descriptorsPerLine + this->descriptorsPerLine - 1
 					].setBuffer(
 							((uint8_t *) this->backBuffer[i / this->mode.vDiv]) - this->dataOffsetInLineInBytes
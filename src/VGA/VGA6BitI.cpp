@@ -15,37 +15,7 @@
 void IRAM_ATTR VGA6BitI::interrupt(void *arg)
 {
 	VGA6BitI * staticthis = (VGA6BitI *)arg;
-
-	//obtain currently rendered line from the buffer just read, based on the conventioned ordering and buffers per line
-	staticthis->currentLine = staticthis->dmaBufferDescriptorActive >> ( (staticthis->descriptorsPerLine==2) ? 1 : 0 );
-
-	//in the case of two buffers per line,
-	//render only when the sync half of the line ended (longer period until next interrupt)
-	//else exit early
-	//This might need to be revised, because it might be better to overlap and miss the second interrupt
-	if ( (staticthis->descriptorsPerLine==2) && ((staticthis->dmaBufferDescriptorActive & 1) != 0) ) return;
-
-	//TO DO: This should be precalculated outside the interrupt
-	int vInactiveLinesCount = staticthis->mode.vFront + staticthis->mode.vSync + staticthis->mode.vBack;
-
-	//render ahead (the lenght of buffered lines)
-	int renderLine = (staticthis->currentLine + staticthis->lineBufferCount);
-	if (renderLine >= staticthis->totalLines) renderLine -= staticthis->totalLines;
-
-	if (renderLine >= vInactiveLinesCount)
-	{
-		int renderActiveLine = renderLine - vInactiveLinesCount;
-		uint8_t *activeRenderingBuffer = ((uint8_t *)
-		staticthis->dmaBufferDescriptors[staticthis->indexRendererDataBuffer[0] + renderActiveLine * staticthis->descriptorsPerLine + staticthis->descriptorsPerLine - 1].buffer() + staticthis->dataOffsetInLineInBytes
-		);
-
-		int y = renderActiveLine / staticthis->mode.vDiv;
-		if (y >= 0 && y < staticthis->yres)
-			staticthis->interruptPixelLine(y, activeRenderingBuffer, arg);
-	}
-
-	if (renderLine == 0)
-		staticthis->vSyncPassed = true;
+	staticthis->renderScheduledLines(&VGA6BitI::interruptPixelLine, arg, staticthis->yres);
 }
 
 	//LOWER LIMIT: THE CODE BETWEEN THESE MARKS IS SHARED BETWEEN 3BIT, 6BIT, AND 14BIT
@@ -55,13 +25,49 @@ void IRAM_ATTR VGA6BitI::interruptPixelLine(int y, uint8_t *pixels, void *arg)
 	VGA6BitI * staticthis = (VGA6BitI *)arg;
 	unsigned long syncBits = (staticthis->hsyncBitI | staticthis->vsyncBitI) * staticthis->rendererStaticReplicate32mask;
 	unsigned char *line = staticthis->frontBuffer[y];
+	int hDiv = staticthis->rowHDiv ? staticthis->rowHDiv[y] : staticthis->mode.hDiv;
 	int j = 0;
-	for (int i = 0; i < staticthis->mode.hRes / 4; i++)
+	if (hDiv == 1)
+	{
+		for (int i = 0; i < staticthis->mode.hRes / 4; i++)
+		{
+			int p0 = (line[j++]) & 63;
+			int p1 = (line[j++]) & 63;
+			int p2 = (line[j++]) & 63;
+			int p3 = (line[j++]) & 63;
+			((uint32_t *)pixels)[i] = syncBits | (p2 << 0) | (p3 << 8) | (p0 << 16) | (p1 << 24);
+		}
+	}
+	else if (hDiv == 2)
+	{
+		//two pixels fill a word, the first one goes to the upper half
+		for (int i = 0; i < staticthis->mode.hRes / 4; i++)
+		{
+			int p0 = (line[j++]) & 63;
+			int p1 = (line[j++]) & 63;
+			((uint32_t *)pixels)[i] = syncBits | (p1 * 0x0101) | (p0 * 0x01010000);
+		}
+	}
+	else if (hDiv == 4)
+	{
+		for (int i = 0; i < staticthis->mode.hRes / 4; i++)
+			((uint32_t *)pixels)[i] = syncBits | ((line[i] & 63) * 0x01010101);
+	}
+	else
 	{
-		int p0 = (line[j++]) & 63;
-		int p1 = (line[j++]) & 63;
-		int p2 = (line[j++]) & 63;
-		int p3 = (line[j++]) & 63;
-		((uint32_t *)pixels)[i] = syncBits | (p2 << 0) | (p3 << 8) | (p0 << 16) | (p1 << 24);
+		//every pixel is sent hDiv times, j moves on after the last one
+		int repeat = hDiv;
+		for (int i = 0; i < staticthis->mode.hRes / 4; i++)
+		{
+			int p0 = (line[j]) & 63;
+			if (--repeat == 0) { repeat = hDiv; j++; }
+			int p1 = (line[j]) & 63;
+			if (--repeat == 0) { repeat = hDiv; j++; }
+			int p2 = (line[j]) & 63;
+			if (--repeat == 0) { repeat = hDiv; j++; }
+			int p3 = (line[j]) & 63;
+			if (--repeat == 0) { repeat = hDiv; j++; }
+			((uint32_t *)pixels)[i] = syncBits | (p2 << 0) | (p3 << 8) | (p0 << 16) | (p1 << 24);
+		}
 	}
 }
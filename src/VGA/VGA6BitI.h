@@ -21,6 +21,7 @@ class VGA6BitI : public VGAI2SDynamic< BLpx1sz8sw2sh0, Graphics<ColorR2G2B2A2, B
 	{
 		frontColor = 0xff;
 		interruptStaticChild = &VGA6BitI::interrupt;
+		renderTaskPixelLine = &VGA6BitI::interruptPixelLine;
 	}
 
 	bool init(const Mode &mode,
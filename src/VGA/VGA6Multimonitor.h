@@ -89,7 +89,7 @@ class VGA6Multimonitor : public VGAI2SOverlapping< BLpx1sz8sw2sh0, Graphics<Colo
 		if(this->dmaBufferDescriptors)
 			for (int i = 0; i < this->yres * this->mode.vDiv / this->my; i++)
 				this->dmaBufferDescriptors[
-						this->indexRendererDataBuffer[(this->currentFrameBuffer + this->frameBufferCount - 1) % this->frameBufferCount]
+						this->indexRendererDataBuffer[this->backRendererBuffer()]
 						 + i * this->descriptorsPerLine + this->descriptorsPerLine - 1
 					].setBuffer(
 							((uint8_t *) this->backBuffer[i / this->mode.vDiv]) - this->dataOffsetInLineInBytes
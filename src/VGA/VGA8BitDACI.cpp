@@ -13,37 +13,7 @@
 void IRAM_ATTR VGA8BitDACI::interrupt(void *arg)
 {
 	VGA8BitDACI * staticthis = (VGA8BitDACI *)arg;
-
-	//obtain currently rendered line from the buffer just read, based on the conventioned ordering and buffers per line
-	staticthis->currentLine = staticthis->dmaBufferDescriptorActive >> ( (staticthis->descriptorsPerLine==2) ? 1 : 0 );
-
-	//in the case of two buffers per line,
-	//render only when the sync half of the line ended (longer period until next interrupt)
-	//else exit early
-	//This might need to be revised, because it might be better to overlap and miss the second interrupt
-	if ( (staticthis->descriptorsPerLine==2) && ((staticthis->dmaBufferDescriptorActive & 1) != 0) ) return;
-
-	//TO DO: This should be precalculated outside the interrupt
-	int vInactiveLinesCount = staticthis->mode.vFront + staticthis->mode.vSync + staticthis->mode.vBack;
-
-	//render ahead (the lenght of buffered lines)
-	int renderLine = (staticthis->currentLine + staticthis->lineBufferCount);
-	if (renderLine >= staticthis->totalLines) renderLine -= staticthis->totalLines;
-
-	if (renderLine >= vInactiveLinesCount)
-	{
-		int renderActiveLine = renderLine - vInactiveLinesCount;
-		uint8_t *activeRenderingBuffer = ((uint8_t *)
-		staticthis->dmaBufferDescriptors[staticthis->indexRendererDataBuffer[0] + renderActiveLine * staticthis->descriptorsPerLine + staticthis->descriptorsPerLine - 1].buffer() + staticthis->dataOffsetInLineInBytes
-		);
-
-		int y = renderActiveLine / staticthis->mode.vDiv;
-		if (y >= 0 && y < staticthis->yres)
-			staticthis->interruptPixelLine(y, activeRenderingBuffer, arg);
-	}
-
-	if (renderLine == 0)
-		staticthis->vSyncPassed = true;
+	staticthis->renderScheduledLines(&VGA8BitDACI::interruptPixelLine, arg, staticthis->yres);
 }
 
 	//LOWER LIMIT: THE CODE BETWEEN THESE MARKS IS SHARED BETWEEN 3BIT, 6BIT, AND 14BIT
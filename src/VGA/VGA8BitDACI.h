@@ -43,6 +43,8 @@ class VGA8BitDACI : public VGAI2SDynamic< BLpx1sz16sw1sh0, GraphicsW8 > // Graph
 		frontColor = 0xff;
 		colorMaxValue = 54;
 		interruptStaticChild = &VGA8BitDACI::interrupt;
+		renderTaskPixelLine = &VGA8BitDACI::interruptPixelLine;
+		repeatsPixels = false;
 	}
 
 	int outputPin = 25;
@@ -0,0 +1,86 @@
+/*
+	Author: Martin-Laclaustra 2021
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://youtube.com/bitlunislab
+		https://github.com/bitluni
+*/
+
+#include <VGA/VGAAttributeTextI.h>
+
+void IRAM_ATTR VGAAttributeTextI::interrupt(void *arg)
+{
+	VGAAttributeTextI * staticthis = (VGAAttributeTextI *)arg;
+	if (staticthis->renderScheduledLines(&VGAAttributeTextI::interruptPixelLine, arg, staticthis->mode.vRes / staticthis->mode.vDiv))
+		if (++staticthis->blinkFrame >= staticthis->blinkFrames)
+			staticthis->blinkFrame = 0;
+}
+
+	//LOWER LIMIT: THE CODE BETWEEN THESE MARKS IS SHARED BETWEEN 3BIT, 6BIT, AND 14BIT
+
+void IRAM_ATTR VGAAttributeTextI::interruptPixelLine(int y, uint8_t *pixels8, void *arg)
+{
+	VGAAttributeTextI * staticthis = (VGAAttributeTextI *)arg;
+	uint32_t *pixels = (uint32_t *)pixels8;
+	uint32_t *pixelsEnd = pixels + staticthis->mode.hRes / 4;
+	const int charWidth = staticthis->font->charWidth;
+	const uint16_t *cells = staticthis->frontBuffer[y / staticthis->font->charHeight];
+	const uint16_t *rows = &staticthis->fontRows[(y % staticthis->font->charHeight) * 256];
+	const uint8_t *attributes = staticthis->blinkMaps[staticthis->blinkState()];
+	uint32_t (*tables)[16] = staticthis->attributeTables;
+
+	if ((charWidth & 3) == 0)
+	{
+		//every nibble belongs to a single cell
+		int fullCells = staticthis->mode.hRes / charWidth;
+		for (int i = 0; i < fullCells; i++)
+		{
+			unsigned int cell = *cells++;
+			const uint32_t *table = tables[attributes[cell >> 8]];
+			unsigned int bits = rows[cell & 0xff];
+			for (int n = charWidth - 4; n >= 0; n -= 4)
+				*pixels++ = table[(bits >> n) & 15];
+		}
+		if (pixels < pixelsEnd)
+		{
+			unsigned int cell = *cells;
+			const uint32_t *table = tables[attributes[cell >> 8]];
+			unsigned int bits = rows[cell & 0xff];
+			for (int n = charWidth - 4; pixels < pixelsEnd; n -= 4)
+				*pixels++ = table[(bits >> n) & 15];
+		}
+		return;
+	}
+
+	//otherwise a nibble can start in one cell and end in the next one,
+	//the first carry pixels of it take the samples of the previous attribute
+	unsigned int carryBits = 0;
+	int carry = 0;
+	const uint32_t *carryTable = tables[0];
+	while (pixels < pixelsEnd)
+	{
+		unsigned int cell = *cells++;
+		const uint32_t *table = tables[attributes[cell >> 8]];
+		unsigned int bits = (carryBits << charWidth) | rows[cell & 0xff];
+		int n = carry + charWidth;
+		if (carry)
+		{
+			n -= 4;
+			unsigned int nibble = (bits >> n) & 15;
+			//pixels 0 and 1 are the upper half of the word, 2 and 3 the lower one
+			uint32_t mask = (carry == 1) ? 0x00ff0000 : ((carry == 2) ? 0xffff0000 : 0xffff00ff);
+			*pixels++ = (carryTable[nibble] & mask) | (table[nibble] & ~mask);
+		}
+		while (n >= 4 && pixels < pixelsEnd)
+		{
+			n -= 4;
+			*pixels++ = table[(bits >> n) & 15];
+		}
+		carry = n;
+		carryBits = bits & ((1 << n) - 1);
+		carryTable = table;
+	}
+}
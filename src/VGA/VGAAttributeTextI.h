@@ -0,0 +1,232 @@
+/*
+	Author: Martin-Laclaustra 2021
+	License: 
+	Creative Commons Attribution ShareAlike 4.0
+	https://creativecommons.org/licenses/by-sa/4.0/
+	
+	For further details check out: 
+		https://youtube.com/bitlunislab
+		https://github.com/bitluni
+*/
+#pragma once
+#include "VGAI2SDynamic.h"
+#include "../Graphics/GraphicsAttributeTextBuffer.h"
+
+//color text mode with an attribute per cell (16 foreground and 16 background colors out of the 64 of the 6 bit output)
+//the font is packed to one bit per pixel and every attribute has a table with the 4 samples of each nibble,
+//so the interrupt writes 4 pixels per lookup, e.g. 80x30 cells with an 8x16 font at 640x480
+//the font has to be set before init and can be 4 to 16 pixels wide
+class VGAAttributeTextI : public VGAI2SDynamic< BLpx1sz8sw2sh0, GraphicsAttributeTextBuffer > // GraphicsAttributeTextBuffer (=) Graphics<ColorW16, BLpx1sz16sw0sh0, CTBIdentity>
+{
+  public:
+	VGAAttributeTextI() //8 bit based modes only work with I2S1
+		: VGAI2SDynamic< BLpx1sz8sw2sh0, GraphicsAttributeTextBuffer >(1)
+	{
+		interruptStaticChild = &VGAAttributeTextI::interrupt;
+		renderTaskPixelLine = &VGAAttributeTextI::interruptPixelLine;
+		repeatsPixels = false;
+		//CGA palette
+		for (int i = 0; i < 16; i++)
+		{
+			int intensity = (i & 8) ? 0x55 : 0;
+			int g = ((i & 2) ? 0xaa : 0) + intensity;
+			if (i == 6) g = 0x55; //brown
+			palette[i] = ColorR2G2B2A2::static_RGBA(((i & 4) ? 0xaa : 0) + intensity, g, ((i & 1) ? 0xaa : 0) + intensity) & 0x3f;
+		}
+		for (int i = 0; i < 256; i++)
+		{
+			blinkMaps[0][i] = i;
+			blinkMaps[1][i] = i & 0x7f;
+			//hidden: foreground in the background color
+			blinkMaps[2][i] = (i & 0x80) ? ((i & 0x70) | ((i >> 4) & 7)) : i;
+		}
+	}
+
+	~VGAAttributeTextI()
+	{
+		deinit();
+	}
+
+	bool init(const Mode &mode,
+			  const int R0Pin, const int R1Pin,
+			  const int G0Pin, const int G1Pin,
+			  const int B0Pin, const int B1Pin,
+			  const int hsyncPin, const int vsyncPin, const int clockPin = -1)
+	{
+		const int bitCount = 8;
+		int pinMap[bitCount] = {
+			R0Pin, R1Pin,
+			G0Pin, G1Pin,
+			B0Pin, B1Pin,
+			hsyncPin, vsyncPin
+		};
+		return initdynamicwritetorenderbuffer(mode, pinMap, bitCount, clockPin);
+	}
+
+	bool init(const Mode &mode, const int *redPins, const int *greenPins, const int *bluePins, const int hsyncPin, const int vsyncPin, const int clockPin = -1, const bool mostSignigicantPinFirst = false)
+	{
+		const int bitCount = 8;
+		int pinMap[bitCount];
+		for (int i = 0; i < 2; i++)
+		{
+			pinMap[i] = redPins[i];
+			pinMap[i + 2] = greenPins[i];
+			pinMap[i + 4] = bluePins[i];
+		}
+		pinMap[6] = hsyncPin;
+		pinMap[7] = vsyncPin;
+
+		if(mostSignigicantPinFirst)
+		{
+			for (int i = 0; i < 2; i++)
+			{
+				pinMap[i] = redPins[1-i];
+				pinMap[i + 2] = greenPins[1-i];
+				pinMap[i + 4] = bluePins[1-i];
+			}
+		}
+
+		return initdynamicwritetorenderbuffer(mode, pinMap, bitCount, clockPin);
+	}
+
+	bool init(const Mode &mode, const PinConfig &pinConfig)
+	{
+		const int bitCount = 8;
+		int pinMap[bitCount];
+		pinConfig.fill6Bit(pinMap);
+		int clockPin = pinConfig.clock;
+
+		return initdynamicwritetorenderbuffer(mode, pinMap, bitCount, clockPin);
+	}
+
+	void releaseFrameMemory(bool keepMemory)
+	override
+	{
+		VGAI2SDynamic< BLpx1sz8sw2sh0, GraphicsAttributeTextBuffer >::releaseFrameMemory(keepMemory);
+		if (keepMemory)
+			return;
+		free(fontRows);
+		free(attributeTables);
+		fontRows = 0;
+		attributeTables = 0;
+	}
+
+	bool initenginePreparation(const Mode &mode, const int *pinMap, const int bitCount, const int clockPin, int descriptorsPerLine = 1)
+	override
+	{
+		if (!font)
+			return false;
+		if (font->charWidth < 4 || font->charWidth > 16)
+			ERROR("VGAAttributeTextI needs a font 4 to 16 pixels wide");
+		this->mode = mode;
+		int xres = (mode.hRes + font->charWidth - 1) / font->charWidth;
+		int yres = ((mode.vRes / mode.vDiv) + font->charHeight - 1) / font->charHeight;
+		initSyncBits();
+		this->vsyncPin = pinMap[8*bytesPerBufferUnit()-1];
+		this->hsyncPin = pinMap[8*bytesPerBufferUnit()-2];
+		totalLines = mode.linesPerField();
+		if(descriptorsPerLine < 1 || descriptorsPerLine > 2) ERROR("Wrong number of descriptors per line");
+		if(descriptorsPerLine == 1) allocateRendererBuffers1DescriptorsPerLine();
+		if(descriptorsPerLine == 2) allocateRendererBuffers2DescriptorsPerLine();
+		propagateResolution(xres, yres);
+		//allocateLineBuffers();
+		packFont();
+		buildAttributeTables();
+		currentLine = 0;
+		vSyncPassed = false;
+		return true;
+	}
+
+	//changes one of the 16 colors of the attributes
+	void setPaletteColor(int index, int r, int g, int b)
+	{
+		index &= 15;
+		palette[index] = ColorR2G2B2A2::static_RGBA(r, g, b) & 0x3f;
+		if (!attributeTables)
+			return;
+		for (int i = 0; i < 16; i++)
+		{
+			buildAttributeTable(index | (i << 4));
+			buildAttributeTable(i | (index << 4));
+		}
+	}
+
+	//with blinking the bit 7 of the attribute makes the character blink instead of selecting the bright backgrounds
+	void setBlink(bool enabled, int framesPerCycle = 32)
+	{
+		blinkFrames = framesPerCycle < 2 ? 2 : framesPerCycle;
+		blinkFrame = 0;
+		blink = enabled;
+	}
+
+  protected:
+	uint8_t palette[16];
+	//samples of the 16 nibbles of every attribute, sync bits included
+	uint32_t (*attributeTables)[16] = 0;
+	//font rows packed to the lower charWidth bits (leftmost pixel highest) [character row][character code]
+	uint16_t *fontRows = 0;
+	//attribute used for the table lookup: no blinking, blinking visible, blinking hidden
+	uint8_t blinkMaps[3][256];
+	bool blink = false;
+	int blinkFrames = 32;
+	int blinkFrame = 0;
+
+	void packFont()
+	{
+		fontRows = (uint16_t *)realloc(fontRows, font->charHeight * 256 * sizeof(uint16_t));
+		if (!fontRows)
+			ERROR("Not enough memory");
+		//invalid characters show as a space, like in VGATextI
+		for (int ch = 0; ch < 256; ch++)
+		{
+			int glyph = font->valid(ch) ? ch : ' ';
+			for (int y = 0; y < font->charHeight; y++)
+			{
+				uint16_t row = 0;
+				if (font->valid(glyph))
+				{
+					const unsigned char *pix = &font->pixels[font->charWidth * (font->charHeight * (glyph - font->firstChar) + y)];
+					for (int x = 0; x < font->charWidth; x++)
+						row = (row << 1) | (pix[x] & 1);
+				}
+				fontRows[y * 256 + ch] = row;
+			}
+		}
+	}
+
+	void buildAttributeTables()
+	{
+		if (!attributeTables)
+			attributeTables = (uint32_t (*)[16])malloc(256 * 16 * sizeof(uint32_t));
+		if (!attributeTables)
+			ERROR("Not enough memory");
+		for (int i = 0; i < 256; i++)
+			buildAttributeTable(i);
+	}
+
+	void buildAttributeTable(int attribute)
+	{
+		unsigned long syncBits = (hsyncBitI | vsyncBitI) * rendererStaticReplicate32mask;
+		uint32_t front = palette[attribute & 15];
+		uint32_t back = palette[attribute >> 4];
+		for (int nibble = 0; nibble < 16; nibble++)
+		{
+			uint32_t samples = syncBits;
+			//the bit 3 of the nibble is the first pixel, the pixels of a word are sent in the order 2, 3, 0, 1
+			for (int x = 0; x < 4; x++)
+				samples |= (((nibble >> (3 - x)) & 1) ? front : back) << (8 * (x ^ 2));
+			attributeTables[attribute][nibble] = samples;
+		}
+	}
+
+	int blinkState() const
+	{
+		if (!blink)
+			return 0;
+		return (blinkFrame < blinkFrames / 2) ? 1 : 2;
+	}
+
+	static void interrupt(void *arg);
+
+	static void interruptPixelLine(int y, uint8_t *pixels, void *arg);
+};
@@ -10,6 +10,9 @@
 #pragma once
 #include "VGAI2SEngine.h"
 #include "../Graphics/Graphics.h"
+#include "../Tools/LineRequestRing.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 
 template<class BufferLayout, class GraphicsCombination>
 class VGAI2SDynamic : public VGAI2SEngine<BufferLayout>, public GraphicsCombination
@@ -21,13 +24,73 @@ class VGAI2SDynamic : public VGAI2SEngine<BufferLayout>, public GraphicsCombinat
 	VGAI2SDynamic(const int i2sIndex = 1)
 		: VGAI2SEngine<BufferLayout>(i2sIndex)
 	{
+		renderTaskHandle = 0;
+		renderTaskCore = -1;
+		renderTaskLines = 0;
+		renderTaskLateLines = 0;
+		lineRows = 0;
+		rowHDiv = 0;
+		repeatsPixels = true;
+	}
+
+	~VGAI2SDynamic()
+	{
+		this->deinit();
+	}
+
+	//converts the lines in a task pinned to the given core instead of inside the interrupt
+	//the interrupt only queues the lines, the render window grows (up to maxRenderAheadLines) whenever a line was late
+	//call before init
+	void setRenderTask(int core = 0, int maxRenderAheadLines = 8)
+	{
+		renderTaskCore = core;
+		renderTaskLines = maxRenderAheadLines;
+	}
+
+	unsigned long getRenderTaskLateLines() const
+	{
+		return renderTaskLateLines;
 	}
 
 	bool initdynamicwritetorenderbuffer(const Mode &mode, const int *pinMap, const int bitCount, const int clockPin = -1)
 	{
-		this->lineBufferCount = 3;
+		this->saveInitPins(pinMap, bitCount, clockPin);
+		//keep a full batch of slack ahead of the beam when several lines are rendered per interrupt
+		this->lineBufferCount = (2 * this->lineBatchCount > 3) ? 2 * this->lineBatchCount : 3;
 		this->rendererBufferCount = 1;
-		return this->initengine(mode, pinMap, bitCount, clockPin, 1); // 1 buffer per line
+		this->renderAheadLines = 0;
+		if (renderTaskCore >= 0)
+		{
+			//the task starts with the same window as the interrupt and may grow into the extra line buffers
+			this->renderAheadLines = this->lineBufferCount;
+			if (renderTaskLines > this->lineBufferCount)
+				this->lineBufferCount = renderTaskLines;
+			if (!renderTaskHandle)
+				xTaskCreatePinnedToCore(renderTask, "VGARenderTask", 2048, this, configMAX_PRIORITIES - 1, (TaskHandle_t *)&renderTaskHandle, renderTaskCore);
+		}
+		lineRequests.clear();
+		//without support in the converter the frame buffer keeps the full width
+		//the converters repeat whole pixels, a divider has to split the line into whole pixels as well
+		Mode sentMode = mode;
+		if (!repeatsPixels)
+			sentMode.hDiv = 1;
+		else if (sentMode.hDiv > 1 && sentMode.hRes % sentMode.hDiv)
+		{
+			DEBUG_PRINTLN("Horizontal divider of the mode does not divide the horizontal resolution, it is ignored");
+			sentMode.hDiv = 1;
+		}
+		this->mode = sentMode;
+		this->completeRegions();
+		for (int r = 0; r < this->regionCount; r++)
+			if (!repeatsPixels)
+				this->regions[r].hDiv = 0;
+			else if (this->regions[r].hDiv > 1 && sentMode.hRes % this->regions[r].hDiv)
+			{
+				DEBUG_PRINTLN("Horizontal divider of a screen region does not divide the horizontal resolution, it is ignored");
+				this->regions[r].hDiv = 0;
+			}
+		buildRegionTables();
+		return this->initengine(sentMode, pinMap, bitCount, clockPin, 1); // 1 buffer per line
 	}
 
 	virtual void propagateResolution(const int xres, const int yres)
@@ -35,16 +98,56 @@ class VGAI2SDynamic : public VGAI2SEngine<BufferLayout>, public GraphicsCombinat
 		this->setResolution(xres, yres);
 	}
 
+	virtual bool initWithSavedPins(const Mode &mode)
+	{
+		return initdynamicwritetorenderbuffer(mode, this->initPinMap, this->initBitCount, this->initClockPin);
+	}
+
+	virtual void releaseFrameMemory(bool keepMemory)
+	{
+		//let the render task finish the lines it was given
+		while (renderTaskHandle && lineRequests.size())
+			delay(1);
+		this->releaseFrameBuffers(keepMemory);
+		free(lineRows);
+		free(rowHDiv);
+		lineRows = 0;
+		rowHDiv = 0;
+		//the next init creates the task again
+		if (!keepMemory && renderTaskHandle)
+		{
+			vTaskDelete((TaskHandle_t)renderTaskHandle);
+			renderTaskHandle = 0;
+		}
+	}
+
+	virtual bool frameMemoryOversized()
+	{
+		return this->frameBufferArena.oversized();
+	}
+
+	//rotates the content of a region by rows (wrapping around), the interrupt picks the rows from the table
+	void setRegionScroll(int region, int rows)
+	{
+		if (region < 0 || region >= this->regionCount)
+			return;
+		int regionRows = this->regionRows(region);
+		this->regions[region].scroll = ((rows % regionRows) + regionRows) % regionRows;
+		if (!lineRows)
+			return;
+		int firstLine = 0;
+		for (int r = 0; r < region; r++)
+			firstLine += this->regions[r].lines;
+		for (int i = firstLine; i < firstLine + this->regions[region].lines; i++)
+			lineRows[i] = this->lineToRow(i);
+	}
+
 	virtual void show(bool vSync = false)
 	{
 		if (!this->frameBufferCount)
 			return;
 		if (vSync)
-		{
-			this->vSyncPassed = false;
-			while (!this->vSyncPassed)
-				delay(0);
-		}
+			this->waitForVSync();
 		GraphicsCombination::show(vSync);
 	}
 
@@ -53,4 +156,129 @@ class VGAI2SDynamic : public VGAI2SEngine<BufferLayout>, public GraphicsCombinat
 	{
 		return true;
 	};
+
+	virtual int frameBufferReadAheadLines() const
+	{
+		return this->lineScheduler.renderAheadLines;
+	}
+
+	//the interrupt of the engines: converts (or queues for the render task) every line not rendered yet
+	//pixelLine converts the frame buffer row y, rows is the number of rows it accepts
+	//returns true when the first line of the frame was among them
+	__attribute__((always_inline)) inline bool renderScheduledLines(void (*pixelLine)(int y, uint8_t *pixels, void *arg), void *arg, int rows)
+	{
+		//obtain the line just finished from the buffer just read, based on the conventioned ordering and buffers per line
+		//only the last (data) descriptor of every lineBatchCount-th line raises EOF, so there is one interrupt per batch
+		this->currentLine = this->dmaBufferDescriptorActive >> ( (this->descriptorsPerLine==2) ? 1 : 0 );
+
+		//TO DO: This should be precalculated outside the interrupt
+		int vInactiveLinesCount = this->mode.vFront + this->mode.vSync + this->mode.vBack;
+
+		LineScheduler &scheduler = this->lineScheduler;
+		scheduler.schedule(this->currentLine);
+		//a line still queued for the render task may be the line above, which is not converted yet
+		bool canRepeat = !(renderTaskHandle && lineRequests.size());
+		bool requestedLines = false;
+		bool frameStarted = false;
+
+		for (int i = 0; i < scheduler.pendingLines; i++)
+		{
+			int renderLine = scheduler.line(i);
+
+			if (renderLine >= vInactiveLinesCount)
+			{
+				int renderActiveLine = renderLine - vInactiveLinesCount;
+				DMABufferDescriptor *renderDescriptor = &this->dmaBufferDescriptors[this->indexRendererDataBuffer[0] + renderActiveLine * this->descriptorsPerLine + this->descriptorsPerLine - 1];
+				uint8_t *activeRenderingBuffer = ((uint8_t *)renderDescriptor->buffer() + this->dataOffsetInLineInBytes);
+
+				int y = lineRows ? lineRows[renderActiveLine] : renderActiveLine / this->mode.vDiv;
+				if (canRepeat && scheduler.repeats(i) && renderActiveLine > 0)
+					renderDescriptor->copyBufferFrom(*(renderDescriptor - this->descriptorsPerLine));
+				else if (y >= 0 && y < rows)
+				{
+					//queue the line for the render task, convert it here if there is no task or no room
+					LineRequest request = {renderLine, y, activeRenderingBuffer};
+					if (renderTaskHandle && lineRequests.push(request))
+						requestedLines = true;
+					else
+						pixelLine(y, activeRenderingBuffer, arg);
+				}
+			}
+
+			if (renderLine == 0)
+			{
+				frameStarted = true;
+				this->vSyncPassed = true;
+				FrameSync::signalFromISR(&this->frameSync, this->currentLine);
+			}
+		}
+		scheduler.finish();
+
+		if (requestedLines)
+		{
+			BaseType_t higherPriorityTaskWoken = pdFALSE;
+			vTaskNotifyGiveFromISR((TaskHandle_t)renderTaskHandle, &higherPriorityTaskWoken);
+			if (higherPriorityTaskWoken)
+				portYIELD_FROM_ISR();
+		}
+		return frameStarted;
+	}
+
+	//frame buffer row of each active line and samples per pixel of each row
+	//only with screen regions, the interrupt can not afford searching the regions every line
+	int16_t *lineRows;
+	uint8_t *rowHDiv;
+	bool repeatsPixels; // the pixel line function honors hDiv
+
+	void buildRegionTables()
+	{
+		free(lineRows);
+		free(rowHDiv);
+		lineRows = 0;
+		rowHDiv = 0;
+		if (!this->regionCount)
+			return;
+		lineRows = (int16_t *)malloc(this->mode.vRes * sizeof(int16_t));
+		rowHDiv = (uint8_t *)malloc(this->frameRows());
+		if (!lineRows || !rowHDiv)
+			ERROR("Not enough memory");
+		for (int i = 0; i < this->mode.vRes; i++)
+			lineRows[i] = this->lineToRow(i);
+		int row = 0;
+		for (int r = 0; r < this->regionCount; r++)
+			for (int i = 0; i < this->regionRows(r); i++)
+				rowHDiv[row++] = this->regionHDiv(r);
+	}
+
+	//members for rendering on the other core
+	void (*renderTaskPixelLine)(int y, uint8_t *pixels, void *arg) = 0;
+	void *renderTaskHandle;
+	int renderTaskCore;
+	int renderTaskLines;
+	volatile unsigned long renderTaskLateLines;
+	LineRequestRing<LineRequest, 32> lineRequests;
+
+	static void renderTask(void *arg)
+	{
+		VGAI2SDynamic *staticthis = (VGAI2SDynamic *)arg;
+		//the pixel line functions expect the same pointer as the interrupt gets
+		void *interruptArg = (I2S *)staticthis;
+		LineRequest request;
+		while (true)
+		{
+			ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+			while (staticthis->lineRequests.pop(request))
+			{
+				//the line after the one just finished is already being sent
+				int distance = request.line - staticthis->currentLine;
+				if (distance < 0) distance += staticthis->totalLines;
+				if (distance < 2)
+				{
+					staticthis->renderTaskLateLines++;
+					staticthis->lineScheduler.requestGrow();
+				}
+				staticthis->renderTaskPixelLine(request.y, request.pixels, interruptArg);
+			}
+		}
+	}
 };
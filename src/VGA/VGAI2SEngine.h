@@ -15,25 +15,34 @@
 #include "../I2S/I2S.h"
 
 #include "../Tools/Log.h"
+#include "../Tools/DMATimeline.h"
+#include "../Tools/LineScheduler.h"
+#include "../Tools/MemoryArena.h"
+#include "ScreenRegion.h"
 
 template<class BufferLayout>
 class VGAI2SEngine : public I2S, public VGA, public BufferLayout
 {
   public:
 	VGAI2SEngine(const int i2sIndex = 0)
-	: I2S(i2sIndex)
+	: I2S(i2sIndex), dmaArena(true)
 	{
 		dmaBufferDescriptors = 0; // I2S member variable
 		lineBufferCount = 1;
+		lineBatchCount = 1;
+		renderAheadLines = 0;
+		frameInterruptOnly = false;
 		rendererBufferCount = 1;
 		rendererStaticReplicate32mask = rendererStaticReplicate32();
+		addedRegionCount = 0;
+		regionCount = 0;
 	}
 
 	virtual bool initenginePreparation(const Mode &mode, const int *pinMap, const int bitCount, const int clockPin = -1, int descriptorsPerLine = 2)
 	{
 		this->mode = mode;
-		int xres = mode.hRes;
-		int yres = mode.vRes / mode.vDiv;
+		int xres = mode.hRes / frameHDiv();
+		int yres = frameRows();
 		initSyncBits();
 		this->vsyncPin = pinMap[8*bytesPerBufferUnit()-1];
 		this->hsyncPin = pinMap[8*bytesPerBufferUnit()-2];
@@ -132,6 +141,10 @@ class VGAI2SEngine : public I2S, public VGA, public BufferLayout
 	// Member variables specific to this engine
 
 	int lineBufferCount;
+	int lineBatchCount; // lines rendered per interrupt (only every lineBatchCount-th line raises EOF)
+	int renderAheadLines; // initial distance from the beam at which lines are rendered, 0 selects lineBufferCount
+	LineScheduler lineScheduler; // lines the interrupt renders
+	bool frameInterruptOnly; // only the last line of the frame raises EOF (modes that do not render lines)
 	int rendererBufferCount;
 	int indexRendererDataBuffer[3];
 	int indexHingeDataBuffer; // last fixed buffer that "jumps" to the active data buffer
@@ -143,6 +156,14 @@ class VGAI2SEngine : public I2S, public VGA, public BufferLayout
 
 	int rendererStaticReplicate32mask = 0;
 
+	MemoryArena dmaArena; // active line buffers (the frame buffers in the overlapping modes)
+
+	static const int maxScreenRegions = ScreenRegion::maxCount;
+	ScreenRegion addedRegions[maxScreenRegions]; // as given to addRegion
+	int addedRegionCount;
+	ScreenRegion regions[maxScreenRegions]; // of the current mode
+	int regionCount;
+
 
 	// Functions specific to this engine
 
@@ -151,9 +172,287 @@ class VGAI2SEngine : public I2S, public VGA, public BufferLayout
 		this->lineBufferCount = lineBufferCount;
 	}
 
+	void setLineBatchCount(int lineBatchCount)
+	{
+		this->lineBatchCount = lineBatchCount < 1 ? 1 : lineBatchCount;
+	}
+
+	//lines the interrupt had to catch up on since init because previous interrupts were skipped
+	unsigned long getMissedLines() const
+	{
+		return lineScheduler.missedLines;
+	}
+
+	//a batch of N lines is rendered after the data descriptor of its last line is consumed,
+	//so the first line of the batch must be rendered in (lineBufferCount - N) line periods
+	void checkLineBatching()
+	{
+		int maxBatch = lineBufferCount - 1;
+		if (maxBatch < 1) maxBatch = 1;
+		if (lineBatchCount > maxBatch)
+			lineBatchCount = maxBatch;
+		if (lineBatchCount > 1 && lineBufferCount < 2 * lineBatchCount)
+		{
+			unsigned long linePeriodNs = (unsigned long)((uint64_t)mode.pixelsPerLine() * 1000000000 / mode.pixelClock);
+			DEBUG_PRINT("Line batching: ");
+			DEBUG_PRINT(lineBatchCount);
+			DEBUG_PRINT(" lines per interrupt, interrupt period (ns) ");
+			DEBUG_PRINT(linePeriodNs * lineBatchCount);
+			DEBUG_PRINT(", render slack (ns) ");
+			DEBUG_PRINTLN(linePeriodNs * (lineBufferCount - lineBatchCount));
+			DEBUG_PRINTLN("Slack is shorter than the batch: expect late lines under load, raise lineBufferCount to 2 * lineBatchCount");
+		}
+	}
+
+	//flag the last descriptor of every lineBatchCount-th line and of the last line of the frame
+	//descriptors of additional renderer buffers mirror the flags of the first one
+	void markInterruptDescriptors()
+	{
+		checkLineBatching();
+		if (renderAheadLines <= lineBatchCount || renderAheadLines > lineBufferCount)
+			renderAheadLines = lineBufferCount;
+		int linesTotal = mode.linesPerField();
+		//the window can grow into all the line buffers
+		lineScheduler.start(linesTotal, lineBatchCount, renderAheadLines, lineBufferCount);
+		int vInactiveLinesCount = linesTotal - mode.vRes;
+		int blankingDescriptorCount = indexRendererDataBuffer[0];
+		for (int i = 0; i < dmaBufferDescriptorCount; i++)
+		{
+			int d = i;
+			if (d >= blankingDescriptorCount)
+				d = vInactiveLinesCount * descriptorsPerLine + (d - blankingDescriptorCount) % (mode.vRes * descriptorsPerLine);
+			else if (blankingDescriptorCount != vInactiveLinesCount * descriptorsPerLine)
+			{
+				//merged blanking lines do not raise interrupts
+				dmaBufferDescriptors[i].setEOF(false);
+				continue;
+			}
+			int line = d / descriptorsPerLine;
+			bool lastOfLine = (d % descriptorsPerLine) == descriptorsPerLine - 1;
+			if (frameInterruptOnly)
+				dmaBufferDescriptors[i].setEOF(lastOfLine && line == linesTotal - 1);
+			else
+				dmaBufferDescriptors[i].setEOF(lastOfLine && (((line + 1) % lineBatchCount) == 0 || line == linesTotal - 1));
+		}
+		//the first descriptor of each renderer buffer tells which one the DMA took at the hinge
+		if (frameInterruptOnly && rendererBufferCount > 1)
+			for (int b = 0; b < rendererBufferCount; b++)
+				dmaBufferDescriptors[indexRendererDataBuffer[b]].setEOF(true);
+#ifdef I2S_INTERRUPT_STATS
+		if (!frameInterruptOnly)
+			setInterruptStatsTiming(lineBatchCount * descriptorsPerLine, descriptorsPerLine, linesTotal * descriptorsPerLine,
+				(long)((uint64_t)mode.pixelsPerLine() * 1000000000 / mode.pixelClock), renderAheadLines - lineBatchCount);
+#endif
+	}
+
 	BufferRendererUnit * getBufferDescriptor(int y, int bufferIndex = 0)
 	{
-		return (BufferRendererUnit *) (dmaBufferDescriptors[indexRendererDataBuffer[bufferIndex] + y*mode.vDiv * descriptorsPerLine + descriptorsPerLine - 1].buffer() + dataOffsetInLineInBytes);
+		return (BufferRendererUnit *) (dmaBufferDescriptors[indexRendererDataBuffer[bufferIndex] + rowToLine(y) * descriptorsPerLine + descriptorsPerLine - 1].buffer() + dataOffsetInLineInBytes);
+	}
+
+	// Screen regions (all lines map to rows with mode.vDiv when there are none)
+
+	//split the screen (top to bottom) in regions before init, the lines not covered form a last default region
+	//bufferCount 1 makes a static region: its rows are the same memory in all frame buffers (drawn once, never flipped)
+	//e.g. a status bar with addRegion(48, 1) below a double-buffered playfield only costs the playfield twice
+	//vDiv (display lines per row) defaults to the one of the mode
+	//hDiv repeats every pixel of the region hDiv times (defaults to the one of the mode), it has to divide mode.hRes
+	//all rows are as wide as the frame buffer (mode.hRes / the lowest hDiv), so hDiv saves conversion time but no memory
+	bool addRegion(int lines, int bufferCount = 0, int vDiv = 0, int hDiv = 0)
+	{
+		if (addedRegionCount >= maxScreenRegions || lines <= 0)
+			return false;
+		ScreenRegion &region = addedRegions[addedRegionCount++];
+		region.lines = lines;
+		region.bufferCount = bufferCount;
+		region.vDiv = vDiv;
+		region.hDiv = hDiv;
+		region.scroll = 0;
+		return true;
+	}
+
+	void clearRegions()
+	{
+		addedRegionCount = 0;
+		regionCount = 0;
+	}
+
+	//the regions of the mode: the added ones cut or completed to cover the active lines exactly
+	//rebuilt from the added regions on every init, scrolling starts over
+	void completeRegions()
+	{
+		bool cut;
+		regionCount = ScreenRegion::complete(regions, addedRegions, addedRegionCount, mode.vRes, cut);
+		if (cut)
+			DEBUG_PRINTLN("Screen regions exceed the vertical resolution, the last ones are cut");
+	}
+
+	int regionVDiv(int region) const
+	{
+		return regions[region].vDiv > 0 ? regions[region].vDiv : mode.vDiv;
+	}
+
+	int regionHDiv(int region) const
+	{
+		return regions[region].hDiv > 0 ? regions[region].hDiv : mode.hDiv;
+	}
+
+	//samples per pixel of the widest rows, sets the width of the frame buffer
+	int frameHDiv() const
+	{
+		int hDiv = regionCount ? regionHDiv(0) : mode.hDiv;
+		for (int r = 1; r < regionCount; r++)
+			if (regionHDiv(r) < hDiv)
+				hDiv = regionHDiv(r);
+		return hDiv;
+	}
+
+	int regionRows(int region) const
+	{
+		return (regions[region].lines + regionVDiv(region) - 1) / regionVDiv(region);
+	}
+
+	//frame buffer rows of the whole active area
+	int frameRows() const
+	{
+		if (!regionCount)
+			return mode.vRes / mode.vDiv;
+		int rows = 0;
+		for (int r = 0; r < regionCount; r++)
+			rows += regionRows(r);
+		return rows;
+	}
+
+	//region showing the active line, with its first line and first row
+	int regionOfLine(int line, int &firstLine, int &firstRow) const
+	{
+		firstLine = 0;
+		firstRow = 0;
+		for (int r = 0; r < regionCount - 1; r++)
+		{
+			if (line < firstLine + regions[r].lines)
+				return r;
+			firstLine += regions[r].lines;
+			firstRow += regionRows(r);
+		}
+		return regionCount - 1;
+	}
+
+	//frame buffer row sent in the active line (scroll included)
+	int lineToRow(int line) const
+	{
+		if (!regionCount)
+			return line / mode.vDiv;
+		int firstLine, firstRow;
+		int r = regionOfLine(line, firstLine, firstRow);
+		return firstRow + ((line - firstLine) / regionVDiv(r) + regions[r].scroll) % regionRows(r);
+	}
+
+	//first active line sending the row before any scroll
+	int rowToLine(int row) const
+	{
+		if (!regionCount)
+			return row * mode.vDiv;
+		int firstLine = 0;
+		for (int r = 0; r < regionCount; r++)
+		{
+			if (row < regionRows(r))
+				return firstLine + row * regionVDiv(r);
+			row -= regionRows(r);
+			firstLine += regions[r].lines;
+		}
+		return firstLine;
+	}
+
+	//rows of static regions use the same memory in all renderer buffers
+	bool rowShared(int row) const
+	{
+		for (int r = 0; r < regionCount; r++)
+		{
+			if (row < regionRows(r))
+				return regions[r].bufferCount == 1;
+			row -= regionRows(r);
+		}
+		return false;
+	}
+
+	// Lifecycle: the pins of the last init are kept for reinit
+
+	static const int maxInitPins = 24;
+	int initPinMap[maxInitPins];
+	int initBitCount = 0;
+	int initClockPin = -1;
+
+	void saveInitPins(const int *pinMap, const int bitCount, const int clockPin)
+	{
+		if (pinMap != initPinMap)
+			for (int i = 0; i < bitCount && i < maxInitPins; i++)
+				initPinMap[i] = pinMap[i];
+		initBitCount = bitCount;
+		initClockPin = clockPin;
+	}
+
+	//stops the output and frees every buffer, init can be called again afterwards
+	void deinit()
+	{
+		stopOutput();
+		releaseFrameMemory(false);
+		dmaArena.release();
+	}
+
+	//switches to another mode on the pins of the last init
+	//the memory blocks of the current mode are reused as far as the new one fits in them
+	//the blocks it leaves unused are freed, a mode needing much less than the kept blocks starts over with new ones
+	bool reinit(const Mode &mode)
+	{
+		if (!initBitCount)
+			return false;
+		stopOutput();
+		releaseFrameMemory(true);
+		dmaArena.reset();
+		if (!initWithSavedPins(mode))
+			return false;
+		dmaArena.trim();
+		if (!dmaArena.oversized() && !frameMemoryOversized())
+			return true;
+		stopOutput();
+		releaseFrameMemory(false);
+		dmaArena.release();
+		return initWithSavedPins(mode);
+	}
+
+	void stopOutput()
+	{
+		if (!dmaBufferDescriptors)
+			return;
+		i2sStop();
+		dmaBufferDescriptors = 0;
+		dmaBufferDescriptorCount = 0;
+	}
+
+	//frame buffers and tables allocated outside the engine (keepMemory leaves the blocks for the next init)
+	virtual void releaseFrameMemory(bool /*keepMemory*/)
+	{
+	}
+
+	//the frame memory kept by the last reinit is mostly spare (the frame buffer arena is trimmed by setResolution)
+	virtual bool frameMemoryOversized()
+	{
+		return false;
+	}
+
+	//repeats the last init with another mode
+	virtual bool initWithSavedPins(const Mode &mode)
+	{
+		return initengine(mode, initPinMap, initBitCount, initClockPin, descriptorsPerLine);
+	}
+
+	void *allocateDMA(int bytes, bool clear = true)
+	{
+		void *b = dmaArena.allocate(bytes, clear);
+		if (!b)
+			ERROR("Not enough DMA memory");
+		return b;
 	}
 
 	void switchToRendererBuffer(int bufferNumber)
@@ -187,6 +486,13 @@ class VGAI2SEngine : public I2S, public VGA, public BufferLayout
 		DEBUG_PRINTLN("");
 	}
 
+	//prototype lines of the vertical blanking timeline
+	enum
+	{
+		timelineBlanking = 0,
+		timelineSync = 1
+	};
+
 	//complete ringbuffer for frame
 	void allocateRendererBuffers2DescriptorsPerLine()
 	{
@@ -198,7 +504,6 @@ class VGAI2SEngine : public I2S, public VGA, public BufferLayout
 		int samplesHData = mode.hRes;
 
 		int sizeHLineComplete = samplesHLineComplete * bytesPerBufferUnit()/samplesPerBufferUnit();
-		int sizeHLineCompleteAligned32 = (sizeHLineComplete + 3) & 0xfffffffc;
 		int sizeHBlanking = samplesHBlanking * bytesPerBufferUnit()/samplesPerBufferUnit();
 		int sizeHBlankingAligned32 = (sizeHBlanking + 3) & 0xfffffffc;
 		int sizeHData = samplesHData * bytesPerBufferUnit()/samplesPerBufferUnit();
@@ -207,26 +512,26 @@ class VGAI2SEngine : public I2S, public VGA, public BufferLayout
 		dataOffsetInLineInBytes = 0;
 
 		//videolines and data videolines for each frame
-		int linesTotal = mode.vFront + mode.vSync + mode.vBack + mode.vRes;
 		int dataLinesBufferCount = lineBufferCount;
 
+		//the frame: the vertical blanking, then the active lines of every renderer buffer
+		//a blanking line goes out with one descriptor unless the interrupt derives the line from the descriptor
+		//(its prototype parts are then back to back, so the blanking part has to keep the word alignment)
+		bool mergeBlanking = frameInterruptOnly && (sizeHBlanking & 3) == 0 && DMATimeline<1>::mergeableLine(sizeHLineComplete);
+		DMATimeline<6, 2> timeline;
+		timeline.add(timelineBlanking, mode.vFront, mergeBlanking);
+		timeline.add(timelineSync, mode.vSync, mergeBlanking);
+		timeline.add(timelineBlanking, mode.vBack, mergeBlanking);
+		for (int b = 0; b < rendererBufferCount; b++)
+			timeline.addData(mode.vRes);
+
 		//calculate DMA buffer descriptors needed
-		dmaBufferDescriptorCount = linesTotal * descriptorsPerLine;
-		//account for more descriptors for additional backbuffers
-		if (rendererBufferCount > 1) dmaBufferDescriptorCount += (rendererBufferCount - 1) * mode.vRes * descriptorsPerLine;
+		dmaBufferDescriptorCount = timeline.compile(descriptorsPerLine);
 		//allocate DMA buffer descriptors for the whole frame
-		dmaBufferDescriptors = DMABufferDescriptor::allocateDescriptors(dmaBufferDescriptorCount);
+		dmaBufferDescriptors = DMABufferDescriptor::allocateDescriptors(dmaBufferDescriptorCount, dmaArena);
 		//link all buffer descriptors in a ring
 		for (int i = 0; i < dmaBufferDescriptorCount; i++)
 			dmaBufferDescriptors[i].next(dmaBufferDescriptors[(i + 1) % dmaBufferDescriptorCount]);
-		//close the ring at the appropriate descriptors in case there are additional backbuffers
-		//and record the position of descriptors for the data part of the buffer
-		for (int b = 0; b < rendererBufferCount; b++)
-		{
-			indexRendererDataBuffer[b] = (mode.vFront + mode.vSync + mode.vBack) * descriptorsPerLine + b * mode.vRes * descriptorsPerLine;
-			dmaBufferDescriptors[indexRendererDataBuffer[b] + mode.vRes * descriptorsPerLine - 1].next(dmaBufferDescriptors[0]);
-		}
-		indexHingeDataBuffer = (mode.vFront + mode.vSync + mode.vBack) * descriptorsPerLine - 1;
 
 
 
@@ -240,17 +545,40 @@ class VGAI2SEngine : public I2S, public VGA, public BufferLayout
 
 		//create the buffers
 		//1 blank prototype line for vFront and vBack
-		vBlankingHBlankingBuffer = DMABufferDescriptor::allocateBuffer(sizeHBlankingAligned32, true);
-		vBlankingHDataBuffer = DMABufferDescriptor::allocateBuffer(sizeHDataAligned32, true);
 		//1 sync prototype line for vSync
-		vSyncHBlankingBuffer = DMABufferDescriptor::allocateBuffer(sizeHBlankingAligned32, true);
-		vSyncHDataBuffer = DMABufferDescriptor::allocateBuffer(sizeHDataAligned32, true);
+		if (mergeBlanking)
+		{
+			//parts back to back, so the line can also be sent whole
+			vBlankingHBlankingBuffer = allocateDMA(sizeHBlanking + sizeHDataAligned32);
+			vBlankingHDataBuffer = (uint8_t *)vBlankingHBlankingBuffer + sizeHBlanking;
+			vSyncHBlankingBuffer = allocateDMA(sizeHBlanking + sizeHDataAligned32);
+			vSyncHDataBuffer = (uint8_t *)vSyncHBlankingBuffer + sizeHBlanking;
+		}
+		else
+		{
+			vBlankingHBlankingBuffer = allocateDMA(sizeHBlankingAligned32);
+			vBlankingHDataBuffer = allocateDMA(sizeHDataAligned32);
+			vSyncHBlankingBuffer = allocateDMA(sizeHBlankingAligned32);
+			vSyncHDataBuffer = allocateDMA(sizeHDataAligned32);
+		}
 		//n lines as buffer for data lines
 		//allocated elsewhere (actually below)
 		DataBuffer = (void **)malloc(rendererBufferCount * dataLinesBufferCount * sizeof(void *));
-		for (int i = 0; i < rendererBufferCount * dataLinesBufferCount; i++)
+		//static regions keep a single copy of their rows
+		int unsharedLines = dataLinesBufferCount;
+		for (int i = dataLinesBufferCount; i < rendererBufferCount * dataLinesBufferCount; i++)
+			if (!rowShared(i % dataLinesBufferCount))
+				unsharedLines++;
+		//the lines are carved from a few large DMA blocks, packed at the start of the array
+		if (!dmaArena.allocateRows(DataBuffer, unsharedLines, sizeHDataAligned32))
+			ERROR("Not enough DMA memory");
+		//then spread backwards (a packed line is never behind its final place) and shared rows point to the first buffer
+		for (int i = rendererBufferCount * dataLinesBufferCount - 1; i >= dataLinesBufferCount; i--)
 		{
-			DataBuffer[i] = DMABufferDescriptor::allocateBuffer(sizeHDataAligned32, true);
+			if (rowShared(i % dataLinesBufferCount))
+				DataBuffer[i] = DataBuffer[i % dataLinesBufferCount];
+			else
+				DataBuffer[i] = DataBuffer[--unsharedLines];
 		}
 		//create a live-refill buffer (when dataLinesBufferCount != mode.vRes/mode.vDiv)
 		// or create a whole buffer, but duplicating lines according to vDiv
@@ -298,30 +626,45 @@ class VGAI2SEngine : public I2S, public VGA, public BufferLayout
 		//assign the buffers accross the DMA buffer descriptors
 		//CONVENTION: the frame starts after the last active (data) line of previous frame
 		//CONVENTION: the line starts after the last active (data) sample of previous line
-		int d = 0;
-		for (int i = 0; i < mode.vFront; i++)
-		{
-			dmaBufferDescriptors[d++].setBuffer(vBlankingHBlankingBuffer, sizeHBlanking);
-			dmaBufferDescriptors[d++].setBuffer(vBlankingHDataBuffer, sizeHData);
-		}
-		for (int i = 0; i < mode.vSync; i++)
-		{
-			dmaBufferDescriptors[d++].setBuffer(vSyncHBlankingBuffer, sizeHBlanking);
-			dmaBufferDescriptors[d++].setBuffer(vSyncHDataBuffer, sizeHData);
-		}
-		for (int i = 0; i < mode.vBack; i++)
-		{
-			dmaBufferDescriptors[d++].setBuffer(vBlankingHBlankingBuffer, sizeHBlanking);
-			dmaBufferDescriptors[d++].setBuffer(vBlankingHDataBuffer, sizeHData);
-		}
-		for (int b = 0; b < rendererBufferCount; b++)
+		//the timeline is compiled in chunks, the descriptions of a whole frame would take a lot of memory
+		TimelineDescriptor chunk[32];
+		for (int first = 0; first < dmaBufferDescriptorCount; first += 32)
 		{
-			for (int i = 0; i < mode.vRes; i++)
+			timeline.compile(descriptorsPerLine, chunk, 32, first);
+			for (int d = first; d < dmaBufferDescriptorCount && d < first + 32; d++)
 			{
-				dmaBufferDescriptors[d++].setBuffer(vBlankingHBlankingBuffer, sizeHBlanking);
-				dmaBufferDescriptors[d++].setBuffer(DataBuffer[b * dataLinesBufferCount + (i/mode.vDiv) % dataLinesBufferCount], sizeHData);
+				TimelineDescriptor &t = chunk[d - first];
+				if (t.segment == TimelineData)
+				{
+					int b = t.line / mode.vRes;
+					int i = t.line % mode.vRes;
+					if (t.part == 0)
+					{
+						//record the position of descriptors for the data part of the buffer
+						//and close the ring after it in case there are additional backbuffers
+						if (i == 0)
+						{
+							indexRendererDataBuffer[b] = d;
+							dmaBufferDescriptors[d + mode.vRes * descriptorsPerLine - 1].next(dmaBufferDescriptors[0]);
+						}
+						dmaBufferDescriptors[d].setBuffer(vBlankingHBlankingBuffer, sizeHBlanking);
+					}
+					else
+						dmaBufferDescriptors[d].setBuffer(DataBuffer[b * dataLinesBufferCount + lineToRow(i) % dataLinesBufferCount], sizeHData);
+					continue;
+				}
+				bool sync = t.prototype == timelineSync;
+				if (t.part < 0)
+					dmaBufferDescriptors[d].setBuffer(sync ? vSyncHBlankingBuffer : vBlankingHBlankingBuffer, sizeHLineComplete);
+				else if (t.part == 0)
+					dmaBufferDescriptors[d].setBuffer(sync ? vSyncHBlankingBuffer : vBlankingHBlankingBuffer, sizeHBlanking);
+				else
+					dmaBufferDescriptors[d].setBuffer(sync ? vSyncHDataBuffer : vBlankingHDataBuffer, sizeHData);
 			}
 		}
+		indexHingeDataBuffer = indexRendererDataBuffer[0] - 1;
+
+		markInterruptDescriptors();
 
 		free(DataBuffer);
 	}
@@ -334,7 +677,6 @@ class VGAI2SEngine : public I2S, public VGA, public BufferLayout
 		//lenght of each line
 		int samplesHLineComplete = mode.hFront + mode.hSync + mode.hBack + mode.hRes;
 		int samplesHBlanking = mode.hFront + mode.hSync + mode.hBack;
-		int samplesHData = mode.hRes;
 
 		int sizeHLineComplete = samplesHLineComplete * bytesPerBufferUnit()/samplesPerBufferUnit();
 		int sizeHLineCompleteAligned32 = (sizeHLineComplete + 3) & 0xfffffffc;
@@ -344,26 +686,24 @@ class VGAI2SEngine : public I2S, public VGA, public BufferLayout
 		dataOffsetInLineInBytes = sizeHBlankingAligned32reduced;
 
 		//videolines and data videolines for each frame
-		int linesTotal = mode.vFront + mode.vSync + mode.vBack + mode.vRes;
 		int dataLinesBufferCount = lineBufferCount;
 
+		//the frame: the vertical blanking, then the active lines of every renderer buffer
+		//(with a descriptor per line there is nothing to merge)
+		DMATimeline<6, 2> timeline;
+		timeline.add(timelineBlanking, mode.vFront, false);
+		timeline.add(timelineSync, mode.vSync, false);
+		timeline.add(timelineBlanking, mode.vBack, false);
+		for (int b = 0; b < rendererBufferCount; b++)
+			timeline.addData(mode.vRes);
+
 		//calculate DMA buffer descriptors needed
-		dmaBufferDescriptorCount = linesTotal * descriptorsPerLine;
-		//account for more descriptors for additional backbuffers
-		if (rendererBufferCount > 1) dmaBufferDescriptorCount += (rendererBufferCount - 1) * mode.vRes * descriptorsPerLine;
+		dmaBufferDescriptorCount = timeline.compile(descriptorsPerLine);
 		//allocate DMA buffer descriptors for the whole frame
-		dmaBufferDescriptors = DMABufferDescriptor::allocateDescriptors(dmaBufferDescriptorCount);
+		dmaBufferDescriptors = DMABufferDescriptor::allocateDescriptors(dmaBufferDescriptorCount, dmaArena);
 		//link all buffer descriptors in a ring
 		for (int i = 0; i < dmaBufferDescriptorCount; i++)
 			dmaBufferDescriptors[i].next(dmaBufferDescriptors[(i + 1) % dmaBufferDescriptorCount]);
-		//close the ring at the appropriate descriptors in case there are additional backbuffers
-		//and record the position of descriptors for the data part of the buffer
-		for (int b = 0; b < rendererBufferCount; b++)
-		{
-			indexRendererDataBuffer[b] = (mode.vFront + mode.vSync + mode.vBack) * descriptorsPerLine + b * mode.vRes * descriptorsPerLine;
-			dmaBufferDescriptors[indexRendererDataBuffer[b] + mode.vRes * descriptorsPerLine - 1].next(dmaBufferDescriptors[0]);
-		}
-		indexHingeDataBuffer = (mode.vFront + mode.vSync + mode.vBack) * descriptorsPerLine - 1;
 
 
 
@@ -375,16 +715,15 @@ class VGAI2SEngine : public I2S, public VGA, public BufferLayout
 
 		//create the buffers
 		//1 blank prototype line for vFront and vBack
-		vBlankingLineBuffer = DMABufferDescriptor::allocateBuffer(sizeHLineCompleteAligned32, true);
+		vBlankingLineBuffer = allocateDMA(sizeHLineCompleteAligned32);
 		//1 sync prototype line for vSync
-		vSyncLineBuffer = DMABufferDescriptor::allocateBuffer(sizeHLineCompleteAligned32, true);
+		vSyncLineBuffer = allocateDMA(sizeHLineCompleteAligned32);
 		//n lines as buffer for data lines
 		//allocated elsewhere (actually below)
 		DataBuffer = (void **)malloc(rendererBufferCount * dataLinesBufferCount * sizeof(void *));
-		for (int i = 0; i < rendererBufferCount * dataLinesBufferCount; i++)
-		{
-			DataBuffer[i] = DMABufferDescriptor::allocateBuffer(sizeHLineCompleteAligned32, true);
-		}
+		//the lines are carved from a few large DMA blocks
+		if (!dmaArena.allocateRows(DataBuffer, rendererBufferCount * dataLinesBufferCount, sizeHLineCompleteAligned32))
+			ERROR("Not enough DMA memory");
 		//create a live-refill buffer (when dataLinesBufferCount != mode.vRes/mode.vDiv)
 		// or create a whole buffer, but duplicating lines according to vDiv
 
@@ -422,26 +761,35 @@ class VGAI2SEngine : public I2S, public VGA, public BufferLayout
 		//assign the buffers accross the DMA buffer descriptors
 		//CONVENTION: the frame starts after the last active (data) line of previous frame
 		//CONVENTION: the line starts after the last active (data) sample of previous line
-		int d = 0;
-		for (int i = 0; i < mode.vFront; i++)
+		TimelineDescriptor chunk[32];
+		for (int first = 0; first < dmaBufferDescriptorCount; first += 32)
 		{
-			dmaBufferDescriptors[d++].setBuffer(vBlankingLineBuffer, sizeHLineComplete);
-		}
-		for (int i = 0; i < mode.vSync; i++)
-		{
-			dmaBufferDescriptors[d++].setBuffer(vSyncLineBuffer, sizeHLineComplete);
-		}
-		for (int i = 0; i < mode.vBack; i++)
-		{
-			dmaBufferDescriptors[d++].setBuffer(vBlankingLineBuffer, sizeHLineComplete);
-		}
-		for (int b = 0; b < rendererBufferCount; b++)
-		{
-			for (int i = 0; i < mode.vRes; i++)
+			timeline.compile(descriptorsPerLine, chunk, 32, first);
+			for (int d = first; d < dmaBufferDescriptorCount && d < first + 32; d++)
 			{
-				dmaBufferDescriptors[d++].setBuffer(DataBuffer[b * dataLinesBufferCount + (i/mode.vDiv) % dataLinesBufferCount], sizeHLineComplete);
+				TimelineDescriptor &t = chunk[d - first];
+				if (t.segment == TimelineData)
+				{
+					int b = t.line / mode.vRes;
+					int i = t.line % mode.vRes;
+					//record the position of descriptors for the data part of the buffer
+					//and close the ring after it in case there are additional backbuffers
+					if (i == 0)
+					{
+						indexRendererDataBuffer[b] = d;
+						dmaBufferDescriptors[d + mode.vRes * descriptorsPerLine - 1].next(dmaBufferDescriptors[0]);
+					}
+					//with regions consecutive lines can show rows far apart, so every line gets the next buffer of the ring
+					int slot = regionCount ? i : i / mode.vDiv;
+					dmaBufferDescriptors[d].setBuffer(DataBuffer[b * dataLinesBufferCount + slot % dataLinesBufferCount], sizeHLineComplete);
+				}
+				else
+					dmaBufferDescriptors[d].setBuffer(t.prototype == timelineSync ? vSyncLineBuffer : vBlankingLineBuffer, sizeHLineComplete);
 			}
 		}
+		indexHingeDataBuffer = indexRendererDataBuffer[0] - 1;
+
+		markInterruptDescriptors();
 
 		free(DataBuffer);
 	}
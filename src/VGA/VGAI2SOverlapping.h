@@ -21,13 +21,35 @@ class VGAI2SOverlapping : public VGAI2SEngine<BufferLayout>, public GraphicsComb
 	VGAI2SOverlapping(const int i2sIndex = 1)
 		: VGAI2SEngine<BufferLayout>(i2sIndex)
 	{
+		//the interrupts mark the end of the frame for waitForVSync()
+		//and the first line of the renderer buffer that goes on screen
+		this->frameInterruptOnly = true;
+		this->interruptStaticChild = &VGAI2SOverlapping::frameInterrupt;
+		displayedBuffer = 0;
 	}
 
 	bool initoverlappingbuffers(const Mode &mode, const int *pinMap, const int bitCount, const int clockPin = -1)
 	{
-		this->lineBufferCount = mode.vRes / mode.vDiv; // yres
+		this->saveInitPins(pinMap, bitCount, clockPin);
+		//the DMA sends the frame buffer rows as they are, pixels can not be repeated
+		Mode sentMode = mode;
+		if (sentMode.hDiv > 1)
+		{
+			DEBUG_PRINTLN("Horizontal divider of the mode is ignored in this mode");
+			sentMode.hDiv = 1;
+		}
+		this->mode = sentMode;
+		this->completeRegions();
+		for (int r = 0; r < this->regionCount; r++)
+			if (this->regions[r].hDiv > 1)
+			{
+				DEBUG_PRINTLN("Horizontal divider of screen regions is ignored in this mode");
+				this->regions[r].hDiv = 0;
+			}
+		this->lineBufferCount = this->frameRows(); // yres
 		this->rendererBufferCount = this->frameBufferCount;
-		return this->initengine(mode, pinMap, bitCount, clockPin, 2); // 2 buffers per line
+		displayedBuffer = 0;
+		return this->initengine(sentMode, pinMap, bitCount, clockPin, 2); // 2 buffers per line
 	}
 
 	virtual void propagateResolution(const int xres, const int yres)
@@ -35,6 +57,37 @@ class VGAI2SOverlapping : public VGAI2SEngine<BufferLayout>, public GraphicsComb
 		this->setResolution(xres, yres);
 	}
 
+	virtual bool initWithSavedPins(const Mode &mode)
+	{
+		return initoverlappingbuffers(mode, this->initPinMap, this->initBitCount, this->initClockPin);
+	}
+
+	virtual void releaseFrameMemory(bool keepMemory)
+	{
+		this->releaseFrameBuffers(keepMemory);
+		currentBufferToAssign = 0;
+	}
+
+	//rotates the content of a region by rows (wrapping around) relinking its DMA descriptors, no pixel is copied
+	//frame buffer row 0 of the region is shown on its first line again with rows = 0
+	void setRegionScroll(int region, int rows)
+	{
+		if (region < 0 || region >= this->regionCount)
+			return;
+		int regionRows = this->regionRows(region);
+		this->regions[region].scroll = ((rows % regionRows) + regionRows) % regionRows;
+		if (!this->dmaBufferDescriptors)
+			return;
+		int firstLine = 0;
+		for (int r = 0; r < region; r++)
+			firstLine += this->regions[r].lines;
+		for (int b = 0; b < this->rendererBufferCount; b++)
+			for (int i = firstLine; i < firstLine + this->regions[region].lines; i++)
+				this->dmaBufferDescriptors[this->indexRendererDataBuffer[b] + i * this->descriptorsPerLine + this->descriptorsPerLine - 1].setBuffer(
+						((uint8_t *) this->frameBuffers[b][this->graphics_swy(this->lineToRow(i))]) - this->dataOffsetInLineInBytes,
+						this->mode.hRes * this->bytesPerBufferUnit() / this->samplesPerBufferUnit());
+	}
+
 	//This auxiliary variable is a trick: when graphic tries to allocate
 	//the memory for the buffers, the function returns instead the
 	//pointer to the previously allocated renderer(DMA) buffers.
@@ -44,7 +97,7 @@ class VGAI2SOverlapping : public VGAI2SEngine<BufferLayout>, public GraphicsComb
 
 	virtual BufferGraphicsUnit **allocateFrameBuffer()
 	{
-		void **arr = (void **)malloc(this->yres * sizeof(void *));
+		void **arr = (void **)this->frameBufferArena.allocate(this->yres * sizeof(void *), false);
 		if(!arr)
 			ERROR("Not enough memory");
 		for (int y = 0; y < this->yres; y++)
@@ -55,35 +108,97 @@ class VGAI2SOverlapping : public VGAI2SEngine<BufferLayout>, public GraphicsComb
 		return (BufferGraphicsUnit **)arr;
 	}
 
+	//the DMA does not run yet during init, the front buffer is linked directly instead of flipping to it with show()
+	virtual bool allocateFrameBuffers()
+	{
+		if (this->yres <= 0 || this->xres <= 0)
+			return false;
+		for (int i = 0; i < this->frameBufferCount; i++)
+			this->frameBuffers[i] = allocateFrameBuffer();
+		this->currentFrameBuffer = 0;
+		GraphicsCombination::show(false);
+		this->backBuffer = this->frameBuffers[backRendererBuffer()];
+		this->switchToRendererBuffer(this->currentFrameBuffer);
+		displayedBuffer = this->currentFrameBuffer;
+		return true;
+	}
+
 	virtual void show(bool vSync = false)
 	{
 		if (!this->frameBufferCount)
 			return;
 
 		GraphicsCombination::show(vSync);
+		// with three buffers draw into the oldest one, it is the last to be sent again
+		this->backBuffer = this->frameBuffers[backRendererBuffer()];
+		// queue the flip, the interrupt reports when the DMA reaches the first line of the new buffer
 		this->switchToRendererBuffer(this->currentFrameBuffer);
-		// wait at least one frame
-		// else the switch does not take place for the display
-		// until the frame is completed
-		// and drawing starts in the backbuffer while still shown
-		if (this->frameBufferCount == 2) // in triple buffer or single buffer this is not an issue
+		if (this->frameBufferCount < 2 || !this->dmaBufferDescriptors)
+			return;
+		// only wait while the buffer to draw into is still on screen
+		// (double buffering, or triple buffering faster than the display)
+		// or if vSync asks for the new frame to be on screen
+		//the timeout (two frames) only matters if the interrupt is not running
+		uint32_t framedurationinms = (uint64_t)this->mode.pixelsPerLine() * (uint64_t)this->mode.linesPerField() * (uint64_t)1000 / (uint64_t)this->mode.pixelClock;
+		//the counter is read before the check, so a flip right after the check still ends the wait
+		while (true)
 		{
-			uint32_t timemark = micros();
-			uint32_t framedurationinus = (uint64_t)this->mode.pixelsPerLine() * (uint64_t)this->mode.linesPerField() * (uint64_t)1000000 / (uint64_t)this->mode.pixelClock;
-			while((micros() - timemark) < framedurationinus){delay(0);}
+			unsigned long flips = flipSync.frameCount();
+			if (displayedBuffer != backRendererBuffer() && (!vSync || displayedBuffer == this->currentFrameBuffer))
+				break;
+			if (!flipSync.waitForFrameAfter(flips, 2 * framedurationinms + 1))
+				break;
 		}
 	}
 
+	//renderer buffer being sent (updated when the DMA reaches its first line)
+	int getDisplayedBuffer() const
+	{
+		return displayedBuffer;
+	}
+
+	//renderer buffer of the back buffer, the one displayed the longest time ago
+	int backRendererBuffer() const
+	{
+		return (this->currentFrameBuffer + 1) % this->frameBufferCount;
+	}
+
+  protected:
+	bool useInterrupt()
+	{
+		return true;
+	};
+
+	volatile int displayedBuffer;
+	FrameSync flipSync;
+
+	static void IRAM_ATTR frameInterrupt(void *arg)
+	{
+		VGAI2SOverlapping * staticthis = (VGAI2SOverlapping *)arg;
+		//the descriptor just sent tells which renderer buffer the DMA took at the hinge,
+		//show() may have relinked the hinge since
+		for (int b = 0; b < staticthis->rendererBufferCount; b++)
+			if (staticthis->dmaBufferDescriptorActive == staticthis->indexRendererDataBuffer[b])
+			{
+				staticthis->displayedBuffer = b;
+				FrameSync::signalFromISR(&staticthis->flipSync);
+				return;
+			}
+		staticthis->vSyncPassed = true;
+		FrameSync::signalFromISR(&staticthis->frameSync, staticthis->totalLines - 1);
+	}
+
+  public:
 	virtual void scroll(int dy, Color color)
 	{
 		GraphicsCombination::scroll(dy, color);
 		if(this->dmaBufferDescriptors)
-			for (int i = 0; i < this->yres * this->mode.vDiv; i++)
+			for (int i = 0; i < (this->regionCount ? this->mode.vRes : this->yres * this->mode.vDiv); i++)
 				this->dmaBufferDescriptors[
-						this->indexRendererDataBuffer[(this->currentFrameBuffer + this->frameBufferCount - 1) % this->frameBufferCount]
+						this->indexRendererDataBuffer[backRendererBuffer()]
 						 + i * this->descriptorsPerLine + this->descriptorsPerLine - 1
 					].setBuffer(
-							((uint8_t *) this->backBuffer[i / this->mode.vDiv]) - this->dataOffsetInLineInBytes
+							((uint8_t *) this->backBuffer[this->lineToRow(i)]) - this->dataOffsetInLineInBytes
 							,
 							((this->descriptorsPerLine > 1)?this->mode.hRes:this->mode.pixelsPerLine()) * this->bytesPerBufferUnit()/this->samplesPerBufferUnit()
 						);
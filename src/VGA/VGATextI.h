@@ -20,6 +20,8 @@ class VGATextI : public VGAI2SDynamic< BLpx1sz8sw2sh0, GraphicsTextBuffer > // G
 	{
 		frontColor = 0xf;
 		interruptStaticChild = &VGATextI::interrupt;
+		renderTaskPixelLine = &VGATextI::interruptPixelLine;
+		repeatsPixels = false;
 	}
 
 	bool init(const Mode &mode, const int RPin, const int GPin, const int BPin, const int hsyncPin, const int vsyncPin, const int clockPin = -1)